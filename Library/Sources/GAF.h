@@ -11,6 +11,8 @@
 #include "GAFAssetTextureManager.h"
 #include "GAFDelegates.h"
 #include "GAFTimeline.h"
+#include "GAFEvaluator.h"
+#include "GAFEventRegistry.h"
 
 #define GAF_VERSION 5.0
 
@@ -23,6 +23,16 @@ const GAFAnimationFrame::SubobjectStates_t& GAFAnimationFrame::getObjectStates()
     return m_subObjectStates;
 }
 
+const GAFAnimationFrame::SubobjectStates_t& GAFAnimationFrame::getVisibleObjectStates() const
+{
+    return m_visibleStates;
+}
+
+const GAFAnimationFrame::SubobjectStates_t& GAFAnimationFrame::getResetStateChanges() const
+{
+    return m_resetStateChanges;
+}
+
 const GAFAnimationFrame::TimelineActions_t & GAFAnimationFrame::getTimelineActions() const
 {
     return m_timelineActions;
@@ -39,4 +49,46 @@ void GAFAnimationFrame::pushTimelineAction(GAFTimelineAction action)
     m_timelineActions.push_back(action);
 }
 
+void GAFAnimationFrame::prepare(const GAFTimeline* timeline, const GAFAnimationFrame* previous)
+{
+    for (GAFTimelineAction& action : m_timelineActions)
+    {
+        action.resolveFrame(timeline);
+    }
+
+    m_visibleStates.clear();
+    m_resetStateChanges.clear();
+    m_visibleObjects.clear();
+
+    std::unordered_map<uint32_t, bool> previousResetStates;
+    if (previous)
+    {
+        for (const GAFSubobjectState* state : previous->m_subObjectStates)
+        {
+            previousResetStates[state->objectIdRef] = state->colorMults()[GAFCTI_A] < 0.f;
+        }
+    }
+
+    for (GAFSubobjectState* state : m_subObjectStates)
+    {
+        if (state->isVisible())
+        {
+            m_visibleStates.push_back(state);
+            if (m_visibleObjects.size() <= state->objectIdRef)
+            {
+                m_visibleObjects.resize(state->objectIdRef + 1, false);
+            }
+            m_visibleObjects[state->objectIdRef] = true;
+            continue;
+        }
+
+        bool isInResetState = state->colorMults()[GAFCTI_A] < 0.f;
+        auto it = previousResetStates.find(state->objectIdRef);
+        if (it == previousResetStates.end() || it->second != isInResetState)
+        {
+            m_resetStateChanges.push_back(state);
+        }
+    }
+}
+
 NS_GAF_END
\ No newline at end of file
@@ -5,6 +5,7 @@ NS_GAF_BEGIN
 
 class GAFTextureAtlas;
 class GAFSubobjectState;
+class GAFTimeline;
 
 class GAFAnimationFrame
 {
@@ -13,15 +14,28 @@ public:
     typedef std::vector<GAFTimelineAction> TimelineActions_t;
 private:
     SubobjectStates_t       m_subObjectStates;
+    SubobjectStates_t       m_visibleStates;
+    SubobjectStates_t       m_resetStateChanges; // Invisible states whose reset flag differs from the previous frame
+    std::vector<bool>       m_visibleObjects;    // Object id -> object has a visible state
     TimelineActions_t       m_timelineActions;
 public:
     GAFAnimationFrame();
     ~GAFAnimationFrame();
     const SubobjectStates_t& getObjectStates() const;
+    const SubobjectStates_t& getVisibleObjectStates() const;
+    const SubobjectStates_t& getResetStateChanges() const;
     const TimelineActions_t& getTimelineActions() const;
+    bool isObjectVisible(uint32_t objectId) const
+    {
+        return objectId < m_visibleObjects.size() && m_visibleObjects[objectId];
+    }
 
     void    pushObjectState(GAFSubobjectState*);
     void    pushTimelineAction(GAFTimelineAction action);
+
+    /// Builds visible states list and reset state transitions relative to the previous frame.
+    /// Resolves goto actions against the timeline
+    void    prepare(const GAFTimeline* timeline, const GAFAnimationFrame* previous);
 };
 
 NS_GAF_END
\ No newline at end of file
@@ -8,6 +8,7 @@ public:
     std::string name;
     uint32_t startFrameNo;
     uint32_t endFrameNo;
+    ax::Rect bounds; // Union of the frame bounds, baked with the timeline bounds
     inline uint32_t length() const
     {
         assert(endFrameNo > startFrameNo);
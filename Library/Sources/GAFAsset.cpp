@@ -1,7 +1,6 @@
 #include "GAFPrecompiled.h"
 #include "GAFAsset.h"
-
-#include <rapidjson/document.h>
+#include "GAFEventRegistry.h"
 
 #include "GAFTextureAtlas.h"
 #include "GAFTextureAtlasElement.h"
@@ -47,6 +46,10 @@ GAFObject * GAFAsset::createObject()
         }
     }
 
+    if (m_isFlattenEnabled)
+    {
+        return GAFObject::create(this, m_rootTimeline->getFlattened(m_timelines));
+    }
     return GAFObject::create(this, m_rootTimeline);
 }
 
@@ -69,6 +72,9 @@ GAFAsset::GAFAsset()
 , m_sceneHeight(0)
 , m_rootTimeline(nullptr)
 , m_desiredAtlasScale(1.0f)
+, m_isFlattenEnabled(false)
+, m_eventListeners(nullptr)
+, m_isEngineEventsEnabled(true)
 , m_state(State::Normal)
 {
 }
@@ -78,6 +84,7 @@ GAFAsset::~GAFAsset()
     GAF_RELEASE_MAP(Timelines_t, m_timelines);
     GAF_RELEASE_MAP(SoundInfos_t, m_soundInfos);
     GAF_RELEASE_ARRAY(TextureAtlases_t, m_textureAtlases);
+    AX_SAFE_DELETE(m_eventListeners);
     //AX_SAFE_RELEASE(m_rootTimeline);
     if (m_state == State::Normal)
     {
@@ -180,6 +187,8 @@ bool GAFAsset::initWithGAFBundle(const std::string& zipFilePath, const std::stri
 
     if (isLoaded && m_state == State::Normal)
     {
+        prepareTimelines();
+        bakeTimelines();
         m_textureManager = new GAFAssetTextureManager();
         GAFShaderManager::Initialize();
         loadTextures(entryFile, delegate, bundle);
@@ -211,6 +220,8 @@ bool GAFAsset::initWithGAFFile(const std::string& filePath, GAFTextureLoadDelega
     }
     if (isLoaded && m_state == State::Normal)
     {
+        prepareTimelines();
+        bakeTimelines();
         m_textureManager = new GAFAssetTextureManager();
         GAFShaderManager::Initialize();
         loadTextures(fullfilePath, delegate);
@@ -290,19 +301,40 @@ void GAFAsset::parseReferences(std::vector<GAFResourcesInfo*>& dest)
     }
 }
 
-void GAFAsset::loadTextures(const std::string& filePath, GAFTextureLoadDelegate_t delegate, ax::ZipFile* bundle /*= nullptr*/)
+void GAFAsset::prepareTimelines()
 {
+    for (Timelines_t::iterator i = m_timelines.begin(), e = m_timelines.end(); i != e; ++i)
+    {
+        i->second->prepare();
+    }
+}
+
+void GAFAsset::bakeTimelines()
+{
+    // Atlas elements and scales are known once the file is parsed, nothing here needs the textures
     for (Timelines_t::iterator i = m_timelines.begin(), e = m_timelines.end(); i != e; i++)
     {
         i->second->loadImages(m_desiredAtlasScale);
+    }
+
+    for (Timelines_t::iterator i = m_timelines.begin(), e = m_timelines.end(); i != e; i++)
+    {
+        i->second->bakeBounds(m_timelines);
+    }
 
+    loadImages(m_desiredAtlasScale);
+}
+
+void GAFAsset::loadTextures(const std::string& filePath, GAFTextureLoadDelegate_t delegate, ax::ZipFile* bundle /*= nullptr*/)
+{
+    for (Timelines_t::iterator i = m_timelines.begin(), e = m_timelines.end(); i != e; i++)
+    {
         if (i->second->getTextureAtlas())
         {
             m_textureManager->appendInfoFromTextureAtlas(i->second->getTextureAtlas());
         }
     }
 
-    loadImages(m_desiredAtlasScale);
     if (getTextureAtlas())
     {
         m_textureManager->appendInfoFromTextureAtlas(getTextureAtlas());
@@ -344,19 +376,12 @@ void GAFAsset::_chooseTextureAtlas(float desiredAtlasScale)
 GAFSprite* GAFAsset::getCustomRegion(const std::string& name)
 {
     GAFTextureAtlas* atlas = getTextureAtlas();
-    const GAFTextureAtlas::Elements_t& elementsMap = atlas->getElements();
     ax::SpriteFrame * spriteFrame = nullptr;
 
-    GAFTextureAtlas::Elements_t::const_iterator elIt = std::find_if(
-        elementsMap.begin(),
-        elementsMap.end(),
-        [name](const std::pair<uint32_t, GAFTextureAtlasElement*>& pair) { return pair.second->name == name; }); // Search for atlas element by its xref
-    
-    assert(elIt != elementsMap.end());
-    const GAFTextureAtlasElement* txElemet = nullptr;
-    if (elIt != elementsMap.end())
+    const GAFTextureAtlasElement* txElemet = atlas->getElementByName(name); // Search for atlas element by its xref
+    assert(txElemet);
+    if (txElemet)
     {
-        txElemet = elIt->second;
         GAFAssetTextureManager* txMgr = getTextureManager();
         ax::Texture2D * texture = txMgr->getTextureById(txElemet->atlasIdx + 1);
         if (texture)
@@ -416,15 +441,11 @@ void GAFAsset::setRootTimeline(GAFTimeline *tl)
 
 bool GAFAsset::setRootTimeline(const std::string& name)
 {
-    for (Timelines_t::iterator i = m_timelines.begin(), e = m_timelines.end(); i != e; i++)
+    GAFTimeline* timeline = getTimelineByName(name);
+    if (timeline)
     {
-        std::string tl_name = i->second->getLinkageName();
-//        if (tl_name.compare(name) == 0)
-        if (tl_name == name)
-        {
-            setRootTimeline(i->second);
-            return true;
-        }
+        setRootTimeline(timeline);
+        return true;
     }
     return false;
 }
@@ -447,19 +468,21 @@ GAFTimeline* GAFAsset::getRootTimeline() const
 
 GAFTimeline* GAFAsset::getTimelineByName(const std::string& name) const
 {
-    for (Timelines_t::value_type it : m_timelines)
-    {
-        if (it.second->getLinkageName() == name)
-            return it.second;
-    }
-
-    return nullptr;
+    TimelinesByLinkage_t::const_iterator it = m_timelinesByLinkage.find(name);
+    return it != m_timelinesByLinkage.end() ? it->second : nullptr;
 }
 
 void GAFAsset::pushTimeline(uint32_t timelineIdRef, GAFTimeline* t)
 {
     m_timelines[timelineIdRef] = t;
     t->retain();
+
+    // Linkage name is read before the timeline is pushed
+    const std::string& linkageName = t->getLinkageName();
+    if (!linkageName.empty())
+    {
+        m_timelinesByLinkage.emplace(linkageName, t);
+    }
 }
 
 void GAFAsset::pushSound(uint32_t id, GAFSoundInfo* sound)
@@ -472,37 +495,39 @@ void GAFAsset::pushTextureAtlas(GAFTextureAtlas* atlas)
     m_textureAtlases.push_back(atlas);
 }
 
-void GAFAsset::soundEvent(GAFTimelineAction *action)
+void GAFAsset::soundEvent(const GAFTimelineAction *action)
 {
     if (!m_soundDelegate) return;
 
-    std::string soundParams = action->getParam(GAFTimelineAction::PI_EVENT_DATA);
-
-    uint32_t soundId;
-    GAFSoundInfo::SyncEvent syncEvent;
-    int32_t repeat = 1;
+    const GAFTimelineAction::SoundCue& cue = action->getSoundCue();
 
-    rapidjson::Document doc;
-    doc.Parse<0>(soundParams.c_str());
-
-    const rapidjson::Value& jsonSoundId = doc["id"];
-    soundId = jsonSoundId.GetInt();
+    SoundInfos_t::iterator it = m_soundInfos.find(cue.id);
+    AX_ASSERT(it != m_soundInfos.end());
+    if (it == m_soundInfos.end()) return;
 
-    const rapidjson::Value& jsonSyncEvent = doc["action"];
-    uint32_t tmpSyncEvent = jsonSyncEvent.GetInt();
-    syncEvent = static_cast<GAFSoundInfo::SyncEvent>(tmpSyncEvent);
+    m_soundDelegate(it->second, cue.repeat, cue.syncEvent);
+}
 
-    if (doc.HasMember("repeat"))
+uint32_t GAFAsset::addEventListener(uint32_t eventId, const GAFEventDelegate_t& delegate)
+{
+    if (!m_eventListeners)
     {
-        const rapidjson::Value& jsonRepeat = doc["repeat"];
-        repeat = jsonRepeat.GetInt();
-        if (repeat == 0) repeat = 1;
+        m_eventListeners = new GAFEventRegistry();
     }
+    return m_eventListeners->addListener(eventId, delegate);
+}
 
-    SoundInfos_t::iterator it = m_soundInfos.find(soundId);
-    AX_ASSERT(it != m_soundInfos.end());
+uint32_t GAFAsset::addEventListener(std::string_view type, const GAFEventDelegate_t& delegate)
+{
+    return addEventListener(GAFEventRegistry::intern(type), delegate);
+}
 
-    m_soundDelegate(it->second, repeat, syncEvent);
+void GAFAsset::removeEventListener(uint32_t handle)
+{
+    if (m_eventListeners)
+    {
+        m_eventListeners->removeListener(handle);
+    }
 }
 
 void GAFAsset::setHeader(GAFHeader& h)
@@ -540,6 +565,28 @@ const Timelines_t& GAFAsset::getTimelines() const
     return m_timelines;
 }
 
+GAFStaticStats GAFAsset::getStaticStats() const
+{
+    GAFStaticStats stats;
+    for (const Timelines_t::value_type& it : m_timelines)
+    {
+        const GAFStaticStats& timelineStats = it.second->getStaticStats();
+        stats.objectCount += timelineStats.objectCount;
+        stats.staticObjectCount += timelineStats.staticObjectCount;
+        stats.timelineCount += timelineStats.timelineCount;
+        stats.staticTimelineCount += timelineStats.staticTimelineCount;
+    }
+    return stats;
+}
+
+void GAFAsset::setEvaluationCacheEnabled(bool enabled)
+{
+    for (Timelines_t::value_type& it : m_timelines)
+    {
+        it.second->setEvaluationCacheEnabled(enabled);
+    }
+}
+
 const GAFHeader& GAFAsset::getHeader() const
 {
     return m_header;
@@ -14,6 +14,7 @@ class GAFTextureAtlas;
 class GAFObject;
 class GAFAssetTextureManager;
 class GAFTimelineAction;
+class GAFEventRegistry;
 
 class GAFLoader;
 
@@ -23,6 +24,7 @@ class GAFAsset : public ax::Object
 private:
     GAFHeader               m_header;
 	Timelines_t				m_timelines;
+    TimelinesByLinkage_t    m_timelinesByLinkage;
     GAFTimeline*            m_rootTimeline;
     SoundInfos_t            m_soundInfos;
     TextureAtlases_t        m_textureAtlases; // custom regions
@@ -31,6 +33,9 @@ private:
     void setRootTimeline(GAFTimeline* tl);
 
     void parseReferences(std::vector<GAFResourcesInfo*> &dest);
+    void prepareTimelines();
+    /// Chooses atlases, converts transforms to cocos axes and bakes bounds and hitboxes. Done right after parsing
+    void bakeTimelines();
     void loadTextures(const std::string& filePath, GAFTextureLoadDelegate_t delegate, ax::ZipFile* bundle = nullptr);
     void _chooseTextureAtlas(float desiredAtlasScale);
     GAFTextureLoadDelegate_t m_textureLoadDelegate;
@@ -44,6 +49,10 @@ private:
     ax::Color4B        m_sceneColor;
 
     float                   m_desiredAtlasScale;
+    bool                    m_isFlattenEnabled;
+
+    GAFEventRegistry*       m_eventListeners; // Created with the first listener
+    bool                    m_isEngineEventsEnabled;
 
     std::string             m_gafFileName;
 
@@ -66,7 +75,7 @@ public:
 
 	void						pushTimeline(uint32_t timelineIdRef, GAFTimeline* t);
     void                        pushSound(uint32_t id, GAFSoundInfo* sound);
-    void                        soundEvent(GAFTimelineAction *action);
+    void                        soundEvent(const GAFTimelineAction *action);
 
     void                        pushTextureAtlas(GAFTextureAtlas* atlas);
 
@@ -81,6 +90,29 @@ public:
 	const Timelines_t&			getTimelines() const;
     Timelines_t&                getTimelines();
 
+    /// Sum of static object statistics of all timelines
+    GAFStaticStats              getStaticStats() const;
+
+    /// Enables the evaluation cache of every timeline, see GAFTimeline::setEvaluationCacheEnabled
+    void                        setEvaluationCacheEnabled(bool enabled);
+
+    /// Objects created after this call play flattened timelines, see GAFTimeline::getFlattened
+    void                        setFlattenEnabled(bool enabled) { m_isFlattenEnabled = enabled; }
+    bool                        isFlattenEnabled() const { return m_isFlattenEnabled; }
+
+    /// Listens to timeline events of every object of the asset, after the listeners of the objects.
+    /// Type ids come from GAFEventRegistry::intern
+    /// @returns handle to remove the listener with
+    uint32_t                    addEventListener(uint32_t eventId, const GAFEventDelegate_t& delegate);
+    uint32_t                    addEventListener(std::string_view type, const GAFEventDelegate_t& delegate);
+    void                        removeEventListener(uint32_t handle);
+    GAFEventRegistry*           getEventListeners() const { return m_eventListeners; }
+
+    /// Timeline events are also dispatched by the engine EventDispatcher as custom events named by the type.
+    /// On by default, turning it off makes events without GAF listeners free
+    void                        setEngineEventsEnabled(bool enabled) { m_isEngineEventsEnabled = enabled; }
+    bool                        isEngineEventsEnabled() const { return m_isEngineEventsEnabled; }
+
     static GAFAsset*            createWithBundle(const std::string& zipfilePath, const std::string& entryFile, GAFTextureLoadDelegate_t delegate, GAFLoader* customLoader = nullptr);
     static GAFAsset*            createWithBundle(const std::string& zipfilePath, const std::string& entryFile);
     static GAFAsset*            create(const std::string& gafFilePath, GAFTextureLoadDelegate_t delegate, GAFLoader* customLoader = nullptr);
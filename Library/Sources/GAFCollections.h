@@ -1,6 +1,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <string_view>
 #include "GAFAnimationSequence.h"
 
 NS_GAF_BEGIN
@@ -80,12 +81,17 @@ typedef std::vector<GAFAnimationFrame*>                     AnimationFrames_t;
 
 typedef std::vector<GAFFilterData*>                         Filters_t;
 typedef std::unordered_map<uint32_t, GAFTimeline*>          Timelines_t;
+typedef std::unordered_map<std::string, GAFTimeline*>       TimelinesByLinkage_t;  // Linkage name -> timeline
 typedef std::unordered_map<uint32_t, GAFTextData*>          TextsData_t;
 
 typedef std::unordered_map<uint32_t, int>                   CaptureObjects_t;      // Object id -> capture flags
 
 typedef std::unordered_map<std::string, GAFAnimationSequence>         AnimationSequences_t;
+typedef std::vector<const GAFAnimationSequence*>                      SequencesByFrame_t;    // Frame number -> sequence
 typedef std::unordered_map<std::string, uint32_t>                     NamedParts_t;
+typedef std::unordered_map<std::string_view, uint32_t>                NamedPartsIndex_t;     // Views to NamedParts_t keys
+typedef std::unordered_map<std::string_view, const GAFAnimationSequence*> SequencesIndex_t;  // Views to AnimationSequences_t keys
+typedef std::vector<uint32_t>                                         ObjectPath_t;          // Object ids of named parts from the outer timeline to the inner one
 
 typedef std::unordered_map<uint32_t, GAFSoundInfo*>         SoundInfos_t;
 
@@ -6,6 +6,7 @@ NS_GAF_BEGIN
 
 class GAFSprite;
 class GAFObject;
+struct GAFEvent;
 
 typedef std::function<void(GAFObject* object, const std::string& sequenceName)>    GAFSequenceDelegate_t;
 typedef std::function<void(GAFObject* obj)>                                        GAFAnimationFinishedPlayDelegate_t;
@@ -13,6 +14,8 @@ typedef std::function<void(GAFObject* obj)>
 typedef std::function<std::string(const std::string&)>                             GAFTextureLoadDelegate_t;
 typedef std::function<void(GAFObject* obj, uint32_t frame)>                        GAFFramePlayedDelegate_t;
 typedef std::function<void(GAFObject* object, const GAFSprite * subobject)>        GAFObjectControlDelegate_t;
+typedef std::function<uint32_t(GAFObject* obj)>                                    GAFLodSelectorDelegate_t;
+typedef std::function<void(const GAFEvent& event)>                                 GAFEventDelegate_t;
 typedef std::function<void(GAFSoundInfo* sound, int32_t repeat, GAFSoundInfo::SyncEvent syncEvent)> GAFSoundDelegate_t;
 
 NS_GAF_END
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "GAFPrecompiled.h"
+#include "GAFEvaluationCache.h"
+
+NS_GAF_BEGIN
+
+std::vector<GAFEvaluationCache*> GAFEvaluationCache::s_retiring;
+std::mutex GAFEvaluationCache::s_retiringMutex;
+
+static bool isTransformEqual(const ax::AffineTransform& t1, const ax::AffineTransform& t2)
+{
+    return t1.a == t2.a && t1.b == t2.b && t1.c == t2.c && t1.d == t2.d && t1.tx == t2.tx && t1.ty == t2.ty;
+}
+
+bool GAFEvaluationCache::Key::operator==(const Key& other) const
+{
+    return parentColorTransforms[0] == other.parentColorTransforms[0]
+        && parentColorTransforms[1] == other.parentColorTransforms[1]
+        && inheritedFilterId == other.inheritedFilterId
+        && anchorOffsetY == other.anchorOffsetY
+        && displayedColor == other.displayedColor
+        && displayedOpacity == other.displayedOpacity
+        && isFlipped == other.isFlipped
+        && (!isFlipped || isTransformEqual(flipCenterTransform, other.flipCenterTransform))
+        && filtersDisabled == other.filtersDisabled;
+}
+
+GAFEvaluationCache::GAFEvaluationCache(uint32_t framesCount)
+: m_slots(framesCount * kMaxEntriesPerFrame)
+, m_nextSlots(framesCount, 0)
+, m_isDestroyed(false)
+{
+    for (std::atomic<const Entry*>& slot : m_slots)
+    {
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+GAFEvaluationCache::~GAFEvaluationCache()
+{
+    for (std::atomic<const Entry*>& slot : m_slots)
+    {
+        delete slot.load(std::memory_order_relaxed);
+    }
+    for (const Entry* entry : m_retired)
+    {
+        delete entry;
+    }
+}
+
+const GAFEvaluationCache::Entry* GAFEvaluationCache::find(uint32_t frame, const Key& key) const
+{
+    if (frame >= m_nextSlots.size())
+    {
+        return nullptr;
+    }
+
+    // Acquire pairs with the release in store, so the values of a found entry are complete
+    const std::atomic<const Entry*>* slots = &m_slots[frame * kMaxEntriesPerFrame];
+    for (uint32_t i = 0; i < kMaxEntriesPerFrame; ++i)
+    {
+        const Entry* entry = slots[i].load(std::memory_order_acquire);
+        if (entry && entry->key == key)
+        {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+const GAFEvaluationCache::Entry* GAFEvaluationCache::store(uint32_t frame, const Key& key, const Values_t& values,
+    const StateIndices_t& nestedStates)
+{
+    if (frame >= m_nextSlots.size())
+    {
+        return nullptr;
+    }
+
+    std::unique_lock<std::mutex> lock(m_writersMutex);
+
+    // Another writer may have published the same key since the caller looked for it
+    if (const Entry* entry = find(frame, key))
+    {
+        return entry;
+    }
+
+    Entry* entry = new Entry();
+    entry->key = key;
+    entry->values = values;
+    entry->nestedStates = nestedStates;
+
+    // Slots are replaced in turn, so short lived inputs do not hold them forever. Readers may still
+    // use the replaced entry, it is freed by collect
+    uint8_t& nextSlot = m_nextSlots[frame];
+    const Entry* replaced = m_slots[frame * kMaxEntriesPerFrame + nextSlot].exchange(entry, std::memory_order_acq_rel);
+    nextSlot = static_cast<uint8_t>((nextSlot + 1) % kMaxEntriesPerFrame);
+
+    if (!replaced)
+    {
+        return entry;
+    }
+
+    const bool isFirstRetired = m_retired.empty();
+    m_retired.push_back(replaced);
+    lock.unlock();
+
+    // Never nested with the writers mutex, collect takes them in the other order
+    if (isFirstRetired)
+    {
+        registerRetiring();
+    }
+    return entry;
+}
+
+void GAFEvaluationCache::registerRetiring()
+{
+    std::lock_guard<std::mutex> lock(s_retiringMutex);
+    if (std::find(s_retiring.begin(), s_retiring.end(), this) == s_retiring.end())
+    {
+        s_retiring.push_back(this);
+    }
+}
+
+void GAFEvaluationCache::destroy()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_writersMutex);
+        for (std::atomic<const Entry*>& slot : m_slots)
+        {
+            if (const Entry* entry = slot.exchange(nullptr, std::memory_order_relaxed))
+            {
+                m_retired.push_back(entry);
+            }
+        }
+        m_isDestroyed = true;
+    }
+    registerRetiring();
+}
+
+bool GAFEvaluationCache::collectRetired()
+{
+    std::lock_guard<std::mutex> lock(m_writersMutex);
+
+    Entries_t::iterator last = std::remove_if(m_retired.begin(), m_retired.end(), [](const Entry* entry)
+    {
+        if (entry->users.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        delete entry;
+        return true;
+    });
+    m_retired.erase(last, m_retired.end());
+    return m_retired.empty();
+}
+
+void GAFEvaluationCache::collect()
+{
+    std::lock_guard<std::mutex> lock(s_retiringMutex);
+
+    std::vector<GAFEvaluationCache*>::iterator last = std::remove_if(s_retiring.begin(), s_retiring.end(), [](GAFEvaluationCache* cache)
+    {
+        if (!cache->collectRetired())
+        {
+            return false;
+        }
+        if (cache->m_isDestroyed)
+        {
+            delete cache;
+        }
+        return true;
+    });
+    s_retiring.erase(last, s_retiring.end());
+}
+
+NS_GAF_END
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+NS_GAF_BEGIN
+
+class GAFFilterData;
+
+/// Evaluated state of a subobject before the instance specific subobject scale is applied
+struct GAFEvaluatedValue
+{
+    ax::AffineTransform transform;
+    GAFFilterData*      filter;
+    float               colorMults[4];
+    float               colorOffsets[4];
+};
+
+/// Values of the visible states of timeline frames shared by the objects playing them with the same inputs.
+/// Every frame keeps the values of up to kMaxEntriesPerFrame different inputs, the oldest one is replaced by a new one.
+/// Entries are published once and never changed, so they are found without locking and may be read from several
+/// threads. Replaced entries are freed by collect once no object uses them
+class GAFEvaluationCache
+{
+public:
+    /// Everything besides the frame the values depend on
+    struct Key
+    {
+        ax::Vec4            parentColorTransforms[2];
+        ax::AffineTransform flipCenterTransform;
+        uint32_t            inheritedFilterId = 0; // GAFFilterData::getId of the custom or the first parent filter, 0 if none
+        float               anchorOffsetY = 0.f;
+        ax::Color3B         displayedColor;
+        uint8_t             displayedOpacity = 0;
+        bool                isFlipped = false;
+        bool                filtersDisabled = false;
+
+        bool operator==(const Key& other) const;
+    };
+
+    typedef std::vector<GAFEvaluatedValue> Values_t; // Visible state index -> value
+    typedef std::vector<uint32_t> StateIndices_t;
+
+    /// Evaluated frame, immutable once published
+    struct Entry
+    {
+        Key             key;
+        Values_t        values;
+        StateIndices_t  nestedStates; // Visible state indices of nested timelines, their inputs are set per instance
+        mutable std::atomic<uint32_t> users; // Objects holding the entry, see acquire
+
+        Entry() : users(0) {}
+        /// Keeps the entry alive after it is replaced, until release is called
+        void acquire() const { users.fetch_add(1, std::memory_order_relaxed); }
+        void release() const { users.fetch_sub(1, std::memory_order_release); }
+    };
+
+    static const uint32_t kMaxEntriesPerFrame = 8;
+
+    explicit GAFEvaluationCache(uint32_t framesCount);
+
+    /// @returns entry of the frame evaluated with the same key, null if there is none. Lock free
+    const Entry* find(uint32_t frame, const Key& key) const;
+    /// Publishes the values of the frame in place of its oldest entry
+    /// @returns the entry with the key
+    const Entry* store(uint32_t frame, const Key& key, const Values_t& values, const StateIndices_t& nestedStates);
+
+    /// Replaces the delete of the cache, it is deleted by collect once its entries are not used
+    void destroy();
+    /// Frees the replaced entries and the destroyed caches nobody uses.
+    /// @note called on the main thread between ticks, while no object is evaluated
+    static void collect();
+
+private:
+    ~GAFEvaluationCache();
+    bool collectRetired(); // @returns true if nothing is left to free
+    void registerRetiring();
+
+    typedef std::vector<const Entry*> Entries_t;
+
+    std::vector<std::atomic<const Entry*>>  m_slots;     // Frame * kMaxEntriesPerFrame + slot -> entry
+    std::vector<uint8_t>    m_nextSlots;                 // Frame -> slot replaced next, guarded by the writers mutex
+    Entries_t               m_retired;                   // Replaced entries, guarded by the writers mutex
+    std::mutex              m_writersMutex;              // Readers never take it
+    bool                    m_isDestroyed;
+
+    static std::vector<GAFEvaluationCache*> s_retiring;  // Caches with retired entries or destroyed
+    static std::mutex       s_retiringMutex;
+};
+
+NS_GAF_END
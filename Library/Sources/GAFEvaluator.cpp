@@ -0,0 +1,183 @@
+#include "GAFPrecompiled.h"
+#include "GAFEvaluator.h"
+#include "GAFAsset.h"
+#include "GAFTimeline.h"
+#include "GAFAnimationFrame.h"
+#include "GAFSubobjectState.h"
+#include "GAFKernels.h"
+
+NS_GAF_BEGIN
+
+void GAFEvaluator::evaluate(const GAFAsset* asset, const GAFTimeline* timeline, uint32_t frame,
+    const GAFNestedFrames_t& nestedFrames, GAFDrawList_t& out)
+{
+    AXASSERT(asset && timeline, "Error! Asset and timeline are required");
+
+    Context context;
+    context.timelines = &asset->getTimelines();
+    context.nestedFrames = &nestedFrames;
+    context.nextNestedFrame = 0;
+    context.depth = 0;
+    context.out = &out;
+
+    static const float identityMults[4] = { 1.f, 1.f, 1.f, 1.f };
+    static const float identityOffsets[4] = { 0.f, 0.f, 0.f, 0.f };
+    evaluateTimeline(context, timeline, frame, IDNONE, ax::AffineTransform::IDENTITY, identityMults, identityOffsets, nullptr);
+}
+
+void GAFEvaluator::evaluateTimeline(Context& context, const GAFTimeline* timeline, uint32_t frame, uint32_t parent,
+    const ax::AffineTransform& parentTransform, const float* parentColorMults, const float* parentColorOffsets,
+    const GAFFilterData* inheritedFilter)
+{
+    const AnimationFrames_t& frames = timeline->getAnimationFrames();
+    if (frame >= frames.size())
+    {
+        return;
+    }
+
+    GAFDrawList_t& out = *context.out;
+    const size_t first = out.size();
+    const AnimationObjects_t& objects = timeline->getAnimationObjects();
+    const AnimationMasks_t& masks = timeline->getAnimationMasks();
+    const GAFAnimationFrame::SubobjectStates_t& states = frames[frame]->getVisibleObjectStates();
+
+    // States of the frame are composed with the parent in one pass, nested frames use the next level of scratch
+    const size_t count = states.size();
+    if (context.scratch.size() <= context.depth)
+    {
+        context.scratch.emplace_back();
+    }
+    std::vector<float>& scratch = context.scratch[context.depth];
+    scratch.resize(count * 14);
+
+    float* p = scratch.data();
+    const GAFTransformsSoA transforms = { p, p + count, p + count * 2, p + count * 3, p + count * 4, p + count * 5 };
+    GAFColorsSoA colors;
+    for (int ch = 0; ch < 4; ++ch)
+    {
+        colors.mults[ch] = p + count * (6 + ch);
+        colors.offsets[ch] = p + count * (10 + ch);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const GAFSubobjectState* state = states[i];
+        const ax::AffineTransform& t = state->cocosTransform;
+        transforms.a[i] = t.a;
+        transforms.b[i] = t.b;
+        transforms.c[i] = t.c;
+        transforms.d[i] = t.d;
+        transforms.tx[i] = t.tx;
+        transforms.ty[i] = t.ty;
+        for (int ch = 0; ch < 4; ++ch)
+        {
+            colors.mults[ch][i] = state->colorMults()[ch];
+            colors.offsets[ch][i] = state->colorOffsets()[ch];
+        }
+    }
+    GAFKernels::concatTransforms(transforms, parentTransform, transforms, count);
+    GAFKernels::composeColorTransforms(colors, parentColorMults, parentColorOffsets, colors, count);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const GAFSubobjectState* state = states[i];
+        bool isMask = false;
+        AnimationObjects_t::const_iterator it = objects.find(state->objectIdRef);
+        if (it == objects.end())
+        {
+            it = masks.find(state->objectIdRef);
+            if (it == masks.end())
+            {
+                continue;
+            }
+            isMask = true;
+        }
+
+        const uint32_t index = static_cast<uint32_t>(out.size());
+        out.emplace_back();
+        GAFDrawItem& item = out.back();
+        item.timeline = timeline->getObjectSource(state->objectIdRef);
+        item.objectId = state->objectIdRef;
+        item.elementId = std::get<0>(it->second);
+        item.charType = std::get<1>(it->second);
+        item.isMask = isMask;
+        item.parent = parent;
+        item.mask = state->maskObjectIdRef; // Resolved to the item index below
+        item.zIndex = state->zIndex;
+        item.transform = ax::AffineTransformMake(transforms.a[i], transforms.b[i], transforms.c[i], transforms.d[i],
+            transforms.tx[i], transforms.ty[i]);
+        item.filter = nullptr;
+
+        const Filters_t& filters = state->getFilters();
+        const GAFFilterData* stateFilter = filters.empty() ? nullptr : filters.front();
+#if ENABLE_RUNTIME_FILTERS
+        // Same as GAFObject::getStateFilter, only textures get filters, the filter of the parent state wins
+        if (item.charType == GAFCharacterType::Texture && !isMask)
+        {
+            item.filter = inheritedFilter ? inheritedFilter : stateFilter;
+        }
+#else
+        (void)inheritedFilter;
+#endif
+
+        for (int ch = 0; ch < 4; ++ch)
+        {
+            item.colorMults[ch] = colors.mults[ch][i];
+            item.colorOffsets[ch] = colors.offsets[ch][i];
+        }
+
+        if (item.charType != GAFCharacterType::Timeline)
+        {
+            continue;
+        }
+
+        Timelines_t::const_iterator nested = context.timelines->find(item.elementId);
+        if (nested == context.timelines->end())
+        {
+            continue;
+        }
+
+        const GAFTimeline* nestedTimeline = nested->second;
+        uint32_t nestedFrame = 0;
+        if (context.nextNestedFrame < context.nestedFrames->size())
+        {
+            nestedFrame = (*context.nestedFrames)[context.nextNestedFrame++];
+        }
+        else if (nestedTimeline->getFramesCount())
+        {
+            nestedFrame = frame % nestedTimeline->getFramesCount();
+        }
+
+        // The item is copied, nested items may reallocate the list. Only the filter of the state placing the
+        // nested timeline is passed down, filters of the timelines above it are not
+        const GAFDrawItem nestedItem = item;
+        ++context.depth;
+        evaluateTimeline(context, nestedTimeline, nestedFrame, index, nestedItem.transform,
+            nestedItem.colorMults, nestedItem.colorOffsets, stateFilter);
+        --context.depth;
+    }
+
+    // Masks are resolved once all items of the frame are placed, a mask may be drawn after the objects it clips
+    for (size_t i = first, count = out.size(); i < count; ++i)
+    {
+        GAFDrawItem& item = out[i];
+        if (item.parent != parent || item.mask == IDNONE)
+        {
+            continue;
+        }
+
+        const uint32_t maskObjectId = item.mask;
+        item.mask = IDNONE;
+        for (size_t j = first; j < count; ++j)
+        {
+            const GAFDrawItem& mask = out[j];
+            if (mask.isMask && mask.parent == parent && mask.objectId == maskObjectId)
+            {
+                item.mask = static_cast<uint32_t>(j);
+                break;
+            }
+        }
+    }
+}
+
+NS_GAF_END
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "GAFCollections.h"
+
+#include <deque>
+
+NS_GAF_BEGIN
+
+class GAFAsset;
+class GAFTimeline;
+class GAFFilterData;
+
+/// Visible object of an evaluated frame
+struct GAFDrawItem
+{
+    const GAFTimeline*      timeline;     // Timeline the element comes from
+    uint32_t                objectId;     // Object id in the timeline playing it
+    uint32_t                elementId;    // Atlas element, text field or nested timeline id depending on the type
+    GAFCharacterType        charType;
+    bool                    isMask;
+    uint32_t                parent;       // Index of the nested timeline item the object is drawn in, IDNONE for the root timeline
+    uint32_t                mask;         // Index of the mask item clipping the object, IDNONE if not masked
+    int                     zIndex;       // Depth within the parent
+    ax::AffineTransform     transform;    // Final transform in the root timeline space, without the node anchor offset
+    const GAFFilterData*    filter;       // Textures only, the filter of the parent state or their own, null if none
+    float                   colorMults[4];
+    float                   colorOffsets[4];
+};
+
+typedef std::vector<GAFDrawItem> GAFDrawList_t;
+/// Frames of the visible nested timelines in the order they are drawn, depth first
+typedef std::vector<uint32_t> GAFNestedFrames_t;
+
+/// Evaluates timeline frames into flat draw lists without nodes, so it needs no Director or renderer
+/// and can run on any thread once the asset is loaded
+class GAFEvaluator
+{
+public:
+    /// Evaluates the frame of the timeline. Items are appended to the list in the order they are drawn.
+    /// Nested timelines are looked up in the asset, pass a flattened timeline to evaluate its expanded objects.
+    /// @param nestedFrames frames nested timelines are at, see GAFObject::getNestedFrames. Nested timelines
+    /// past the end of the list are evaluated at the frame of their parent looped over their length
+    static void evaluate(const GAFAsset* asset, const GAFTimeline* timeline, uint32_t frame,
+        const GAFNestedFrames_t& nestedFrames, GAFDrawList_t& out);
+
+private:
+    struct Context
+    {
+        const Timelines_t*          timelines;
+        const GAFNestedFrames_t*    nestedFrames;
+        size_t                      nextNestedFrame;
+        uint32_t                    depth;
+        std::deque<std::vector<float>> scratch; // Nesting depth -> SoA states of the frame evaluated at the depth
+        GAFDrawList_t*              out;
+    };
+
+    static void evaluateTimeline(Context& context, const GAFTimeline* timeline, uint32_t frame, uint32_t parent,
+        const ax::AffineTransform& parentTransform, const float* parentColorMults, const float* parentColorOffsets,
+        const GAFFilterData* inheritedFilter);
+};
+
+NS_GAF_END
@@ -0,0 +1,212 @@
+#include "GAFPrecompiled.h"
+#include "GAFEventRegistry.h"
+#include "GAFTimelineAction.h"
+
+#include <deque>
+#include <mutex>
+
+NS_GAF_BEGIN
+
+namespace
+{
+    struct EventTypes
+    {
+        std::mutex                                  mutex;
+        std::unordered_map<std::string, uint32_t>   ids;
+        std::deque<std::string>                     types; // Id -> type, references stay valid as types are added
+    };
+
+    EventTypes& getEventTypes()
+    {
+        static EventTypes s_types;
+        return s_types;
+    }
+}
+
+static const std::string s_emptyType;
+
+const std::string& GAFEvent::getType() const
+{
+    return action->getParam(GAFTimelineAction::PI_EVENT_TYPE);
+}
+
+const std::string& GAFEvent::getData() const
+{
+    return action->getParam(GAFTimelineAction::PI_EVENT_DATA);
+}
+
+uint32_t GAFEventRegistry::intern(std::string_view type)
+{
+    EventTypes& types = getEventTypes();
+    std::lock_guard<std::mutex> lock(types.mutex);
+
+    std::string key(type);
+    auto it = types.ids.find(key);
+    if (it != types.ids.end())
+    {
+        return it->second;
+    }
+
+    const uint32_t id = static_cast<uint32_t>(types.types.size());
+    types.types.push_back(key);
+    types.ids.emplace(std::move(key), id);
+    return id;
+}
+
+uint32_t GAFEventRegistry::find(std::string_view type)
+{
+    EventTypes& types = getEventTypes();
+    std::lock_guard<std::mutex> lock(types.mutex);
+
+    auto it = types.ids.find(std::string(type));
+    return it != types.ids.end() ? it->second : IDNONE;
+}
+
+const std::string& GAFEventRegistry::getType(uint32_t id)
+{
+    EventTypes& types = getEventTypes();
+    std::lock_guard<std::mutex> lock(types.mutex);
+
+    return id < types.types.size() ? types.types[id] : s_emptyType;
+}
+
+GAFEventRegistry::GAFEventRegistry()
+: m_nextHandle(0)
+, m_dispatchDepth(0)
+, m_hasRemovedListeners(false)
+{
+}
+
+uint32_t GAFEventRegistry::addListener(uint32_t id, const GAFEventDelegate_t& delegate)
+{
+    AXASSERT(id != IDNONE && delegate, "Error! Listener needs an event id and a delegate");
+    if (id == IDNONE || !delegate)
+    {
+        return IDNONE;
+    }
+
+    if (id >= m_listenerCounts.size())
+    {
+        m_listenerCounts.resize(id + 1, 0);
+    }
+
+    Listener listener;
+    listener.handle = m_nextHandle++;
+    listener.delegate = delegate;
+    listener.isRemoved = false;
+    ++m_listenerCounts[id];
+
+    // Lists are not changed while they are iterated, added listeners wait for the next event
+    m_addedListeners.emplace_back(id, std::move(listener));
+    compact();
+    return m_nextHandle - 1;
+}
+
+void GAFEventRegistry::removeListener(uint32_t handle)
+{
+    for (size_t id = 0; id < m_listeners.size(); ++id)
+    {
+        for (Listener& listener : m_listeners[id])
+        {
+            if (listener.handle == handle && !listener.isRemoved)
+            {
+                listener.isRemoved = true;
+                --m_listenerCounts[id];
+                m_hasRemovedListeners = true;
+                compact();
+                return;
+            }
+        }
+    }
+
+    for (std::pair<uint32_t, Listener>& added : m_addedListeners)
+    {
+        if (added.second.handle == handle && !added.second.isRemoved)
+        {
+            added.second.isRemoved = true;
+            --m_listenerCounts[added.first];
+            m_hasRemovedListeners = true;
+            return;
+        }
+    }
+}
+
+void GAFEventRegistry::removeListeners(uint32_t id)
+{
+    if (id >= m_listenerCounts.size())
+    {
+        return;
+    }
+
+    if (id < m_listeners.size())
+    {
+        for (Listener& listener : m_listeners[id])
+        {
+            listener.isRemoved = true;
+        }
+    }
+    for (std::pair<uint32_t, Listener>& added : m_addedListeners)
+    {
+        if (added.first == id)
+        {
+            added.second.isRemoved = true;
+        }
+    }
+    m_listenerCounts[id] = 0;
+    m_hasRemovedListeners = true;
+    compact();
+}
+
+void GAFEventRegistry::dispatch(const GAFEvent& event)
+{
+    if (!hasListeners(event.id) || event.id >= m_listeners.size())
+    {
+        return;
+    }
+
+    ++m_dispatchDepth;
+    for (const Listener& listener : m_listeners[event.id])
+    {
+        if (!listener.isRemoved)
+        {
+            listener.delegate(event);
+        }
+    }
+    --m_dispatchDepth;
+
+    compact();
+}
+
+void GAFEventRegistry::compact()
+{
+    if (m_dispatchDepth)
+    {
+        return;
+    }
+
+    if (m_hasRemovedListeners)
+    {
+        for (Listeners_t& listeners : m_listeners)
+        {
+            listeners.erase(std::remove_if(listeners.begin(), listeners.end(),
+                [](const Listener& listener) { return listener.isRemoved; }), listeners.end());
+        }
+        m_hasRemovedListeners = false;
+    }
+
+    for (std::pair<uint32_t, Listener>& added : m_addedListeners)
+    {
+        if (added.second.isRemoved)
+        {
+            continue;
+        }
+        if (added.first >= m_listeners.size())
+        {
+            m_listeners.resize(added.first + 1);
+        }
+        m_listeners[added.first].push_back(std::move(added.second));
+    }
+    m_addedListeners.clear();
+}
+
+NS_GAF_END
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "GAFDelegates.h"
+
+NS_GAF_BEGIN
+
+class GAFObject;
+class GAFTimelineAction;
+
+/// Timeline event passed to the listeners
+struct GAFEvent
+{
+    uint32_t                    id;     // Interned event type
+    GAFObject*                  object; // Object playing the timeline with the event
+    const GAFTimelineAction*    action;
+
+    const std::string&          getType() const;
+    const std::string&          getData() const;
+};
+
+/// Listeners of timeline events keyed by interned event ids.
+/// Event types are interned process wide, so ids are the same for every asset
+class GAFEventRegistry
+{
+public:
+    /// Id of the event type, the type is added if it is not known yet. Thread safe
+    static uint32_t     intern(std::string_view type);
+    /// Id of the event type, IDNONE if no asset or listener uses it. Thread safe
+    static uint32_t     find(std::string_view type);
+    static const std::string& getType(uint32_t id);
+
+    GAFEventRegistry();
+
+    /// @returns handle to remove the listener with
+    uint32_t            addListener(uint32_t id, const GAFEventDelegate_t& delegate);
+    void                removeListener(uint32_t handle);
+    void                removeListeners(uint32_t id);
+    bool                hasListeners(uint32_t id) const { return id < m_listenerCounts.size() && m_listenerCounts[id]; }
+
+    /// Calls listeners of the event in the order they were added. Listeners may be added and removed by the listeners
+    void                dispatch(const GAFEvent& event);
+
+private:
+    struct Listener
+    {
+        uint32_t            handle;
+        GAFEventDelegate_t  delegate;
+        bool                isRemoved; // Erased once no dispatch is running
+    };
+    typedef std::vector<Listener> Listeners_t;
+
+    /// Erases removed listeners and appends the ones added during dispatch
+    void                compact();
+
+    std::vector<Listeners_t> m_listeners;      // Event id -> listeners
+    std::vector<std::pair<uint32_t, Listener>> m_addedListeners; // Added during a dispatch, event id and listener
+    std::vector<uint32_t>    m_listenerCounts; // Event id -> listeners not removed
+    uint32_t                 m_nextHandle;
+    uint32_t                 m_dispatchDepth;
+    bool                     m_hasRemovedListeners;
+};
+
+NS_GAF_END
@@ -4,8 +4,16 @@
 #include "GAFMovieClip.h"
 #include "GAFFilterManager.h"
 
+#include <atomic>
+
 NS_GAF_BEGIN
 
+uint32_t GAFFilterData::nextId()
+{
+    static std::atomic<uint32_t> s_lastId(0);
+    return ++s_lastId;
+}
+
 GAFBlurFilterData::GAFBlurFilterData():
 GAFFilterData(GAFFilterType::Blur)
 {
@@ -66,9 +74,20 @@ void GAFDropShadowFilterData::apply(GAFMovieClip* subObject)
 {
     ax::Texture2D* texture = subObject->getInitialTexture();
     const ax::Rect& texRect = subObject->getInitialTextureRect();
-    ax::Texture2D* shadow = GAFFilterManager::getInstance()->applyFilter(ax::Sprite::createWithTexture(texture, texRect), this);
+
+    // The shadow child is kept while the texture and the filter values stay the same. Values are compared,
+    // filters of animated shadows are different objects every frame and freed addresses may be reused
+    const GAFFilterManager::Key key = GAFFilterManager::makeKey(texture, texRect, this);
+    const GAFFilterManager::Key* currentKey = subObject->getDropShadowKey();
+    if (currentKey && *currentKey == key)
+    {
+        return;
+    }
+
+    ax::Texture2D* shadow = GAFFilterManager::getInstance()->applyFilter(texture, texRect, this);
     ax::Sprite* shadowSprite = ax::Sprite::createWithTexture(shadow);
     reset(subObject);
+    subObject->setDropShadowKey(&key);
 
     shadowSprite->setTag(kShadowObjectTag);
     shadowSprite->setOpacity(static_cast<uint8_t>(ax::clampf(strength, 0.0, 1.0) * 255));
@@ -82,6 +101,12 @@ void GAFDropShadowFilterData::apply(GAFMovieClip* subObject)
 
 void GAFDropShadowFilterData::reset(GAFMovieClip* subObject)
 {
+    if (!subObject->getDropShadowKey())
+    {
+        return;
+    }
+    subObject->setDropShadowKey(nullptr);
+
     ax::Node* prevShadowObject = subObject->getChildByTag(kShadowObjectTag);
 
     if (prevShadowObject)
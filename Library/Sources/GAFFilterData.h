@@ -9,6 +9,7 @@ class GAFFilterData
 {
 protected:
     GAFFilterType m_type;
+    uint32_t      m_id;
 public:
 
     virtual ~GAFFilterData() {}
@@ -18,9 +19,28 @@ public:
         return m_type;
     }
 
-    GAFFilterData(GAFFilterType type) : m_type(type)
+    /// Unique for every filter ever created, copies get their own. Never 0
+    uint32_t                getId() const
+    {
+        return m_id;
+    }
+
+    GAFFilterData(GAFFilterType type) : m_type(type), m_id(nextId())
+    {}
+
+    GAFFilterData(const GAFFilterData& other) : m_type(other.m_type), m_id(nextId())
     {}
 
+    GAFFilterData& operator=(const GAFFilterData& other)
+    {
+        m_type = other.m_type;
+        return *this;
+    }
+
+private:
+    static uint32_t nextId();
+public:
+
     virtual void apply(GAFMovieClip*){};
 };
 
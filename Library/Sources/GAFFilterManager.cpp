@@ -43,49 +43,81 @@ void GAFFilterManager::update(float dt)
 
 Texture2D* GAFFilterManager::applyFilter(ax::Sprite* texture, GAFFilterData* filter)
 {
-    auto id = hash(texture, filter);
-    if(hasTexture(id))
-    {
+    return applyFilter(texture->getTexture(), texture->getTextureRect(), filter);
+}
 
-        return *s_cache[id];
-    }
-    else
+Texture2D* GAFFilterManager::applyFilter(ax::Texture2D* texture, const ax::Rect& rect, GAFFilterData* filter)
+{
+    auto id = hash(texture, rect, filter);
+    auto it = s_cache.find(id);
+    if (it != s_cache.end())
     {
-        return renderFilteredTexture(texture, filter, id);
+        return *it->second;
     }
+
+    return renderFilteredTexture(Sprite::createWithTexture(texture, rect), filter, id);
 }
 
 unsigned int GAFFilterManager::hash(Sprite* sprite, GAFFilterData* filter)
 {
-    struct Hash
-    {
-        void* texture;
-        Rect rect;
-        GAFBlurFilterData blur;
-        GAFGlowFilterData glow;
-        GAFDropShadowFilterData shadow;
-    };
+    return hash(sprite->getTexture(), sprite->getTextureRect(), filter);
+}
 
-    Hash hash;
-    memset((void*)&hash, 0, sizeof(Hash));
+unsigned int GAFFilterManager::hash(Texture2D* texture, const Rect& rect, GAFFilterData* filter)
+{
+    const Key key = makeKey(texture, rect, filter);
+    return XXH32(&key, sizeof(Key), 0);
+}
 
-    hash.texture = sprite->getTexture();  // getName();
-    hash.rect = sprite->getTextureRect();
+GAFFilterManager::Key GAFFilterManager::makeKey(Texture2D* texture, const Rect& rect, const GAFFilterData* filter)
+{
+    // Plain values only, so equal filters give equal keys whatever the padding of the filter classes is
+    Key hash;
+    memset((void*)&hash, 0, sizeof(Key));
+
+    hash.texture = texture;
+    hash.rect[0] = rect.origin.x;
+    hash.rect[1] = rect.origin.y;
+    hash.rect[2] = rect.size.width;
+    hash.rect[3] = rect.size.height;
+    hash.type = static_cast<uint32_t>(filter->getType());
 
     if (filter->getType() == GAFFilterType::Blur)
     {
-        hash.blur = *static_cast<GAFBlurFilterData*>(filter);
+        const GAFBlurFilterData* blur = static_cast<const GAFBlurFilterData*>(filter);
+        hash.params[0] = blur->blurSize.width;
+        hash.params[1] = blur->blurSize.height;
     }
     else if (filter->getType() == GAFFilterType::Glow)
     {
-        hash.glow = *static_cast<GAFGlowFilterData*>(filter);
+        const GAFGlowFilterData* glow = static_cast<const GAFGlowFilterData*>(filter);
+        hash.params[0] = glow->color.r;
+        hash.params[1] = glow->color.g;
+        hash.params[2] = glow->color.b;
+        hash.params[3] = glow->color.a;
+        hash.params[4] = glow->blurSize.width;
+        hash.params[5] = glow->blurSize.height;
+        hash.params[6] = glow->strength;
+        hash.params[7] = glow->innerGlow ? 1.f : 0.f;
+        hash.params[8] = glow->knockout ? 1.f : 0.f;
     }
     else if (filter->getType() == GAFFilterType::DropShadow)
     {
-        hash.shadow = *static_cast<GAFDropShadowFilterData*>(filter);
+        const GAFDropShadowFilterData* shadow = static_cast<const GAFDropShadowFilterData*>(filter);
+        hash.params[0] = shadow->color.r;
+        hash.params[1] = shadow->color.g;
+        hash.params[2] = shadow->color.b;
+        hash.params[3] = shadow->color.a;
+        hash.params[4] = shadow->blurSize.width;
+        hash.params[5] = shadow->blurSize.height;
+        hash.params[6] = shadow->angle;
+        hash.params[7] = shadow->distance;
+        hash.params[8] = shadow->strength;
+        hash.params[9] = shadow->innerShadow ? 1.f : 0.f;
+        hash.params[10] = shadow->knockout ? 1.f : 0.f;
     }
-    
-    return XXH32(&hash, sizeof(Hash), 0);
+
+    return hash;
 }
 
 bool GAFFilterManager::hasTexture(unsigned int id)
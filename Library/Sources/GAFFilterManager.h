@@ -15,11 +15,27 @@ class GAFFilterManager : public ax::Object
     typedef std::pair<unsigned int, GAFCachedTexture> CachePair_t;
     
 public:
+    /// Plain values a filtered texture depends on, equal for equal filters wherever they are allocated
+    struct Key
+    {
+        void*       texture;
+        float       rect[4];
+        uint32_t    type;
+        float       params[11];
+
+        bool operator==(const Key& other) const { return memcmp(this, &other, sizeof(Key)) == 0; }
+        bool operator!=(const Key& other) const { return !(*this == other); }
+    };
+
+    static Key makeKey(ax::Texture2D* texture, const ax::Rect& rect, const GAFFilterData* filter);
+
     bool init();
     static GAFFilterManager* getInstance();
     ~GAFFilterManager() {}
 
     ax::Texture2D* applyFilter(ax::Sprite*, GAFFilterData*);
+    /// Same as above, the sprite to render is only created when the filtered texture is not cached
+    ax::Texture2D* applyFilter(ax::Texture2D* texture, const ax::Rect& rect, GAFFilterData*);
 
     void update(float dt);
 
@@ -29,6 +45,7 @@ private:
     GAFFilterManager() {}
 
     unsigned int hash(ax::Sprite*, GAFFilterData*);
+    unsigned int hash(ax::Texture2D* texture, const ax::Rect& rect, GAFFilterData*);
     bool hasTexture(unsigned int);
     ax::Texture2D* renderFilteredTexture(ax::Sprite* sprite, GAFFilterData* filter);
     ax::Texture2D* renderFilteredTexture(ax::Sprite* sprite, GAFFilterData* filter, unsigned int hash);
@@ -0,0 +1,136 @@
+#include "GAFPrecompiled.h"
+#include "GAFKernels.h"
+
+#if !defined(GAF_DISABLE_SIMD) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#define GAF_SIMD_SSE 1
+#include <xmmintrin.h>
+#elif !defined(GAF_DISABLE_SIMD) && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#define GAF_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+
+NS_GAF_BEGIN
+
+#if GAF_SIMD_SSE
+typedef __m128 Lane_t;
+static inline Lane_t laneLoad(const float* p) { return _mm_loadu_ps(p); }
+static inline void laneStore(float* p, Lane_t v) { _mm_storeu_ps(p, v); }
+static inline Lane_t laneSet(float v) { return _mm_set1_ps(v); }
+static inline Lane_t laneAdd(Lane_t a, Lane_t b) { return _mm_add_ps(a, b); }
+static inline Lane_t laneMul(Lane_t a, Lane_t b) { return _mm_mul_ps(a, b); }
+#elif GAF_SIMD_NEON
+typedef float32x4_t Lane_t;
+static inline Lane_t laneLoad(const float* p) { return vld1q_f32(p); }
+static inline void laneStore(float* p, Lane_t v) { vst1q_f32(p, v); }
+static inline Lane_t laneSet(float v) { return vdupq_n_f32(v); }
+static inline Lane_t laneAdd(Lane_t a, Lane_t b) { return vaddq_f32(a, b); }
+static inline Lane_t laneMul(Lane_t a, Lane_t b) { return vmulq_f32(a, b); }
+#endif
+
+#if GAF_SIMD_SSE || GAF_SIMD_NEON
+static const size_t kLaneWidth = 4;
+#else
+static const size_t kLaneWidth = 1;
+#endif
+
+void GAFKernels::concatTransformsScalar(const GAFTransformsSoA& in, const ax::AffineTransform& parent, const GAFTransformsSoA& out,
+    size_t first, size_t count)
+{
+    for (size_t i = first; i < count; ++i)
+    {
+        const float a = in.a[i];
+        const float b = in.b[i];
+        const float c = in.c[i];
+        const float d = in.d[i];
+        const float tx = in.tx[i];
+        const float ty = in.ty[i];
+
+        out.a[i] = a * parent.a + b * parent.c;
+        out.b[i] = a * parent.b + b * parent.d;
+        out.c[i] = c * parent.a + d * parent.c;
+        out.d[i] = c * parent.b + d * parent.d;
+        out.tx[i] = tx * parent.a + ty * parent.c + parent.tx;
+        out.ty[i] = tx * parent.b + ty * parent.d + parent.ty;
+    }
+}
+
+void GAFKernels::composeColorTransformsScalar(const GAFColorsSoA& in, const float* parentMults, const float* parentOffsets,
+    const GAFColorsSoA& out, size_t first, size_t count)
+{
+    for (int ch = 0; ch < 4; ++ch)
+    {
+        for (size_t i = first; i < count; ++i)
+        {
+            out.mults[ch][i] = in.mults[ch][i] * parentMults[ch];
+            out.offsets[ch][i] = in.offsets[ch][i] + parentOffsets[ch];
+        }
+    }
+}
+
+void GAFKernels::concatTransforms(const GAFTransformsSoA& in, const ax::AffineTransform& parent, const GAFTransformsSoA& out, size_t count)
+{
+    const size_t vectorized = count - count % kLaneWidth;
+
+#if GAF_SIMD_SSE || GAF_SIMD_NEON
+    const Lane_t pa = laneSet(parent.a);
+    const Lane_t pb = laneSet(parent.b);
+    const Lane_t pc = laneSet(parent.c);
+    const Lane_t pd = laneSet(parent.d);
+    const Lane_t ptx = laneSet(parent.tx);
+    const Lane_t pty = laneSet(parent.ty);
+
+    for (size_t i = 0; i < vectorized; i += kLaneWidth)
+    {
+        // Everything is loaded before the stores, so the output may alias the input
+        const Lane_t a = laneLoad(in.a + i);
+        const Lane_t b = laneLoad(in.b + i);
+        const Lane_t c = laneLoad(in.c + i);
+        const Lane_t d = laneLoad(in.d + i);
+        const Lane_t tx = laneLoad(in.tx + i);
+        const Lane_t ty = laneLoad(in.ty + i);
+
+        laneStore(out.a + i, laneAdd(laneMul(a, pa), laneMul(b, pc)));
+        laneStore(out.b + i, laneAdd(laneMul(a, pb), laneMul(b, pd)));
+        laneStore(out.c + i, laneAdd(laneMul(c, pa), laneMul(d, pc)));
+        laneStore(out.d + i, laneAdd(laneMul(c, pb), laneMul(d, pd)));
+        laneStore(out.tx + i, laneAdd(laneAdd(laneMul(tx, pa), laneMul(ty, pc)), ptx));
+        laneStore(out.ty + i, laneAdd(laneAdd(laneMul(tx, pb), laneMul(ty, pd)), pty));
+    }
+#endif
+
+    concatTransformsScalar(in, parent, out, vectorized, count);
+}
+
+void GAFKernels::composeColorTransforms(const GAFColorsSoA& in, const float* parentMults, const float* parentOffsets,
+    const GAFColorsSoA& out, size_t count)
+{
+    const size_t vectorized = count - count % kLaneWidth;
+
+#if GAF_SIMD_SSE || GAF_SIMD_NEON
+    for (int ch = 0; ch < 4; ++ch)
+    {
+        const Lane_t mult = laneSet(parentMults[ch]);
+        const Lane_t offset = laneSet(parentOffsets[ch]);
+        for (size_t i = 0; i < vectorized; i += kLaneWidth)
+        {
+            laneStore(out.mults[ch] + i, laneMul(laneLoad(in.mults[ch] + i), mult));
+            laneStore(out.offsets[ch] + i, laneAdd(laneLoad(in.offsets[ch] + i), offset));
+        }
+    }
+#endif
+
+    composeColorTransformsScalar(in, parentMults, parentOffsets, out, vectorized, count);
+}
+
+const char* GAFKernels::getInstructionSet()
+{
+#if GAF_SIMD_SSE
+    return "SSE";
+#elif GAF_SIMD_NEON
+    return "NEON";
+#else
+    return "Scalar";
+#endif
+}
+
+NS_GAF_END
@@ -0,0 +1,45 @@
+#pragma once
+
+NS_GAF_BEGIN
+
+/// Affine transforms in SoA layout, one array per component
+struct GAFTransformsSoA
+{
+    float* a;
+    float* b;
+    float* c;
+    float* d;
+    float* tx;
+    float* ty;
+};
+
+/// Color transforms in SoA layout, one array per channel
+struct GAFColorsSoA
+{
+    float* mults[4];
+    float* offsets[4];
+};
+
+/// Batch kernels composing whole frames of states with their parent in one pass.
+/// Vectorized with SSE or NEON when the target has it, GAF_DISABLE_SIMD forces the scalar code.
+/// Output may be the same arrays as the input
+class GAFKernels
+{
+public:
+    /// out[i] = AffineTransformConcat(in[i], parent)
+    static void concatTransforms(const GAFTransformsSoA& in, const ax::AffineTransform& parent, const GAFTransformsSoA& out, size_t count);
+    /// out.mults[ch][i] = in.mults[ch][i] * parentMults[ch], out.offsets[ch][i] = in.offsets[ch][i] + parentOffsets[ch]
+    static void composeColorTransforms(const GAFColorsSoA& in, const float* parentMults, const float* parentOffsets,
+        const GAFColorsSoA& out, size_t count);
+
+    /// Scalar versions the vectorized kernels are checked against
+    static void concatTransformsScalar(const GAFTransformsSoA& in, const ax::AffineTransform& parent, const GAFTransformsSoA& out,
+        size_t first, size_t count);
+    static void composeColorTransformsScalar(const GAFColorsSoA& in, const float* parentMults, const float* parentOffsets,
+        const GAFColorsSoA& out, size_t first, size_t count);
+
+    /// "SSE", "NEON" or "Scalar"
+    static const char* getInstructionSet();
+};
+
+NS_GAF_END
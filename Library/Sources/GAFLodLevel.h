@@ -0,0 +1,17 @@
+#pragma once
+
+NS_GAF_BEGIN
+
+/// Playback cost settings of a GAFObject, selected by the on-screen scale or by GAFLodSelectorDelegate_t
+struct GAFLodLevel
+{
+    float       minScale = 0.f;             // The first level with minScale not above the on-screen scale is used
+    uint32_t    frameDecimation = 1;        // Shows every n-th played frame, others are only advanced
+    bool        skipNestedTimelines = false; // Nested timelines keep their current frame
+    bool        disableFilters = false;     // Runtime filters are not applied
+    bool        freeze = false;             // Keeps showing the current frame, playback and events go on
+};
+
+typedef std::vector<GAFLodLevel> LodLevels_t;
+
+NS_GAF_END
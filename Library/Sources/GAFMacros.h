@@ -38,3 +38,8 @@ for (__type::iterator i = __instance.begin(), e = __instance.end(); i != e; ++i)
 #endif
 
 #define CHECK_CTX_IDENTITY 1
+
+#ifndef ENABLE_RUNTIME_FILTERS
+// Filters of the states are applied to the textures drawn by objects and evaluated draw lists
+#define ENABLE_RUNTIME_FILTERS 1
+#endif
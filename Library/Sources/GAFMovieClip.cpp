@@ -32,6 +32,7 @@ m_initialTexture(nullptr),
 m_colorMatrixFilterData(nullptr),
 m_glowFilterData(nullptr),
 m_blurFilterData(nullptr),
+m_hasDropShadow(false),
 m_programBase(nullptr),
 m_programNoCtx(nullptr),
 m_ctxDirty(false),
@@ -132,11 +133,11 @@ void GAFMovieClip::updateTextureWithEffects()
 
         if (m_blurFilterData)
         {
-            resultTex = GAFFilterManager::getInstance()->applyFilter(Sprite::createWithTexture(m_initialTexture, m_initialTextureRect), m_blurFilterData);
+            resultTex = GAFFilterManager::getInstance()->applyFilter(m_initialTexture, m_initialTextureRect, m_blurFilterData);
         }
         else if (m_glowFilterData)
         {
-            resultTex = GAFFilterManager::getInstance()->applyFilter(Sprite::createWithTexture(m_initialTexture, m_initialTextureRect), m_glowFilterData);
+            resultTex = GAFFilterManager::getInstance()->applyFilter(m_initialTexture, m_initialTextureRect, m_glowFilterData);
         }
 
         if (resultTex)
@@ -266,6 +267,15 @@ void GAFMovieClip::setBlurFilterData(GAFBlurFilterData* data)
     }
 }
 
+void GAFMovieClip::setDropShadowKey(const GAFFilterManager::Key* key)
+{
+    m_hasDropShadow = key != nullptr;
+    if (key)
+    {
+        m_dropShadowKey = *key;
+    }
+}
+
 ax::Texture2D* GAFMovieClip::getInitialTexture() const
 {
     return m_initialTexture;
@@ -1,12 +1,14 @@
 #pragma once
 
 #include "GAFObject.h"
+#include "GAFFilterManager.h"
 
 NS_GAF_BEGIN
 
 class GAFColorMatrixFilterData;
 class GAFGlowFilterData;
 class GAFBlurFilterData;
+class GAFDropShadowFilterData;
 
 class GAFMovieClip : public GAFObject
 {
@@ -22,6 +24,8 @@ protected:
     GAFColorMatrixFilterData*   m_colorMatrixFilterData;
     GAFGlowFilterData*          m_glowFilterData;
     GAFBlurFilterData*          m_blurFilterData;
+    GAFFilterManager::Key       m_dropShadowKey;        // Texture and filter values of the current shadow child
+    bool                        m_hasDropShadow;
     ax::Texture2D *             m_initialTexture;
     ax::Rect                    m_initialTextureRect;
     ax::ProgramState*           m_programBase;
@@ -45,6 +49,9 @@ public:
     void setColorMarixFilterData(GAFColorMatrixFilterData* data);
     void setGlowFilterData(GAFGlowFilterData* data);
     void setBlurFilterData(GAFBlurFilterData* data);
+    /// Remembers what the shadow child is built from, null when the child is removed
+    void setDropShadowKey(const GAFFilterManager::Key* key);
+    const GAFFilterManager::Key* getDropShadowKey() const { return m_hasDropShadow ? &m_dropShadowKey : nullptr; }
 
     ax::Texture2D*    getInitialTexture() const;
     const ax::Rect&   getInitialTextureRect() const;
@@ -11,16 +11,17 @@
 #include "GAFSubobjectState.h"
 #include "GAFFilterData.h"
 #include "GAFTextField.h"
+#include "GAFPlaybackManager.h"
+#include "GAFKernels.h"
 
 #include <math/TransformUtils.h>
-
-#define ENABLE_RUNTIME_FILTERS 1
+#include <charconv>
 
 NS_GAF_BEGIN
 
 static const AnimationSequences_t s_emptySequences = AnimationSequences_t();
 
-const ax::AffineTransform GAFObject::AffineTransformFlashToCocos(const ax::AffineTransform& aTransform)
+const ax::AffineTransform GAFObject::AffineTransformFlashToCocos(const ax::AffineTransform& aTransform) const
 {
     ax::AffineTransform transform = aTransform;
     transform.b = -transform.b;
@@ -43,14 +44,49 @@ GAFObject::GAFObject()
     , m_timeDelta(0.0)
     , m_fps(0)
     , m_skipFpsCheck(false)
+    , m_isCatchUpEnabled(false)
+    , m_isCullingEnabled(false)
+    , m_isCulled(false)
+    , m_culledTick(UINT_MAX)
+    , m_isInterpolationEnabled(false)
+    , m_interpolationFactor(0.f)
+    , m_appliedInterpolationFactor(0.f)
+    , m_lodLevelIndex(IDNONE)
+    , m_lodSkippedFrames(0)
     , m_asset(nullptr)
     , m_timeline(nullptr)
     , m_currentFrame(GAFFirstFrameIndex)
     , m_showingFrame(GAFFirstFrameIndex)
-    , m_lastVisibleInFrame(0)
+    , m_lastRealizedFrame(IDNONE)
     , m_objectType(GAFObjectType::None)
     , m_animationsSelectorScheduled(false)
     , m_isInResetState(false)
+    , m_playbackIndex(IDNONE)
+    , m_playbackClock(IDNONE)
+    , m_isTickPaused(false)
+    , m_queuedFramePlayed(IDNONE)
+    , m_staticRangeFirst(IDNONE)
+    , m_staticRangeLast(IDNONE)
+    , m_staticRevision(1)
+    , m_appliedStaticRevision(0)
+    , m_evaluatedFrame(nullptr)
+    , m_evaluatedEntry(nullptr)
+    , m_evaluatedValues(nullptr)
+    , m_evaluatedNestedStates(nullptr)
+    , m_batchFlippedCount(0)
+    , m_lastEvaluatedFrame(IDNONE)
+    , m_appliedRevision(0)
+    , m_isEvaluatedFrameChanged(false)
+    , m_isEvaluatedDirty(false)
+    , m_isNestedPlaying(true)
+    , m_isNestedChanged(true)
+    , m_isRealizeDeferred(false)
+    , m_eventListeners(nullptr)
+    , m_isFastForwarding(false)
+    , m_checkpointInterval(0)
+    , m_checkpointSequenceStart(IDNONE)
+    , m_checkpointSequenceEnd(IDNONE)
+    , m_checkpointReversed(false)
     , m_customFilter(nullptr)
     , m_isManualColor(false)
 {
@@ -62,10 +98,12 @@ GAFObject::GAFObject()
 GAFObject::~GAFObject()
 {
     stop();
+    setEvaluatedEntry(nullptr);
     GAF_SAFE_RELEASE_ARRAY_WITH_NULL_CHECK(MaskList_t, m_masks);
     GAF_SAFE_RELEASE_ARRAY_WITH_NULL_CHECK(DisplayList_t, m_displayList);
     AX_SAFE_RELEASE(m_asset);
     AX_SAFE_DELETE(m_customFilter);
+    AX_SAFE_DELETE(m_eventListeners);
 }
 
 GAFObject * GAFObject::create(GAFAsset * anAsset, GAFTimeline* timeline)
@@ -127,8 +165,17 @@ void GAFObject::constructObject()
     GAF_SAFE_RELEASE_ARRAY_WITH_NULL_CHECK(DisplayList_t, m_displayList);
 
     m_fps = m_asset->getSceneFps();
+    GAFPlaybackManager::getInstance()->updateFps(this);
 
     m_animationsSelectorScheduled = false;
+    m_lastRealizedFrame = IDNONE;
+    m_lastEvaluatedFrame = IDNONE;
+    m_evaluatedFrame = nullptr;
+    setEvaluatedEntry(nullptr);
+    m_evaluatedValues = nullptr;
+    m_evaluatedNestedStates = nullptr;
+    m_staticRangeFirst = m_staticRangeLast = IDNONE;
+    clearCheckpoints();
 
     instantiateObject(m_timeline->getAnimationObjects(), m_timeline->getAnimationMasks());
 }
@@ -142,8 +189,9 @@ GAFObject* GAFObject::_instantiateObject(uint32_t id, GAFCharacterType type, uin
     }
     else if (type == GAFCharacterType::TextField)
     {
-        TextsData_t::const_iterator it = m_timeline->getTextsData().find(reference);
-        if (it != m_timeline->getTextsData().end())
+        const TextsData_t& textsData = m_timeline->getObjectSource(id)->getTextsData();
+        TextsData_t::const_iterator it = textsData.find(reference);
+        if (it != textsData.end())
         {
             GAFTextField *tf = new GAFTextField();
             tf->initWithTextData(it->second);
@@ -152,14 +200,11 @@ GAFObject* GAFObject::_instantiateObject(uint32_t id, GAFCharacterType type, uin
     }
     else if (type == GAFCharacterType::Texture)
     {
-        GAFTextureAtlas* atlas = m_timeline->getTextureAtlas();
-        const GAFTextureAtlas::Elements_t& elementsMap = atlas->getElements();
+        GAFTextureAtlas* atlas = m_timeline->getObjectSource(id)->getTextureAtlas();
         ax::SpriteFrame * spriteFrame = nullptr;
-        GAFTextureAtlas::Elements_t::const_iterator elIt = elementsMap.find(reference); // Search for atlas element by its xref
-        const GAFTextureAtlasElement* txElemet = nullptr;
-        if (elIt != elementsMap.end())
+        const GAFTextureAtlasElement* txElemet = atlas->getElement(reference); // Search for atlas element by its xref
+        if (txElemet)
         {
-            txElemet = elIt->second;
             GAFAssetTextureManager* txMgr = m_asset->getTextureManager();
             ax::Texture2D * texture = txMgr->getTextureById(txElemet->atlasIdx + 1);
             if (texture)
@@ -178,7 +223,6 @@ GAFObject* GAFObject::_instantiateObject(uint32_t id, GAFCharacterType type, uin
             else
                 result = new GAFMask();
             result->initWithSpriteFrame(spriteFrame, txElemet->rotation);
-            result->objectIdRef = id;
             ax::Vec2 pt = ax::Vec2(0 - (0 - (txElemet->pivotPoint.x / result->getContentSize().width)),
                 0 + (1 - (txElemet->pivotPoint.y / result->getContentSize().height)));
             result->setAnchorPoint(pt);
@@ -191,7 +235,10 @@ GAFObject* GAFObject::_instantiateObject(uint32_t id, GAFCharacterType type, uin
         }
     }
     if (result)
+    {
+        result->objectIdRef = id;
         result->setTimelineParentObject(this);
+    }
     return result;
 }
 
@@ -246,8 +293,14 @@ GAFObject* GAFObject::encloseNewTimeline(uint32_t reference)
 
     AXASSERT(tl != timelines.end(), "Invalid object reference.");
 
+    GAFTimeline* timeline = tl->second;
+    if (m_asset->isFlattenEnabled())
+    {
+        timeline = timeline->getFlattened(timelines);
+    }
+
     GAFObject* newObject = new GAFObject();
-    newObject->init(m_asset, tl->second);
+    newObject->init(m_asset, timeline);
     return newObject;
 }
 
@@ -264,6 +317,7 @@ void GAFObject::processAnimation()
 void GAFObject::setAnimationRunning(bool value, bool recursive)
 {
     m_isRunning = value;
+    markNestedChanged();
 
     if (recursive)
     {
@@ -303,6 +357,11 @@ void GAFObject::setFramePlayedDelegate(GAFFramePlayedDelegate_t delegate)
     m_framePlayedDelegate = delegate;
 }
 
+void GAFObject::setLodSelectorDelegate(GAFLodSelectorDelegate_t delegate)
+{
+    m_lodSelectorDelegate = delegate;
+}
+
 void GAFObject::start()
 {
     enableTick(true);
@@ -328,40 +387,148 @@ void GAFObject::processAnimations(float dt)
 {
     if (m_skipFpsCheck)
     {
-        step();
-        if (m_framePlayedDelegate)
-        {
-            m_framePlayedDelegate(this, m_currentFrame);
-        }
+        playFrames(1);
     }
     else
     {
         m_timeDelta += dt;
         double frameTime = 1.0 / m_fps;
+        uint32_t frames = 0;
         while (m_timeDelta >= frameTime)
         {
             m_timeDelta -= frameTime;
-            step();
+            ++frames;
+        }
+        updateInterpolationFactor(m_timeDelta);
+        if (frames)
+        {
+            playFrames(frames);
+        }
+        else
+        {
+            interpolateFrame();
+        }
+    }
+}
+
+void GAFObject::updateInterpolationFactor(double timeDelta)
+{
+    m_interpolationFactor = m_isInterpolationEnabled && !m_skipFpsCheck
+        ? std::min(static_cast<float>(timeDelta * m_fps), 1.f) : 0.f;
+}
+
+bool GAFObject::isInterpolating() const
+{
+    return m_interpolationFactor > 0.f && getIsAnimationRunning() && m_lastRealizedFrame != IDNONE;
+}
+
+void GAFObject::interpolateFrame()
+{
+    if (!isInterpolating() || updateCulling())
+    {
+        return;
+    }
 
-            if (m_framePlayedDelegate)
+    evaluateFrame();
+    applyFrame(m_container);
+}
+
+bool GAFObject::playFrames(uint32_t count)
+{
+    updateLod();
+
+    const bool isRealizeDeferred = m_isRealizeDeferred;
+    bool isFrameDue = false;
+    bool isFrameShown = false;
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        // Frames decimated by LOD are only advanced
+        if (m_lodSkippedFrames + 1 < m_lod.frameDecimation)
+        {
+            ++m_lodSkippedFrames;
+        }
+        else
+        {
+            isFrameDue = true;
+        }
+
+        // Skipped frames are only advanced, the last one is realized
+        const bool isShown = isFrameDue && !m_lod.freeze && (!m_isCatchUpEnabled || i + 1 == count);
+        if (isShown)
+        {
+            m_lodSkippedFrames = 0;
+            isFrameDue = false;
+            isFrameShown = true;
+        }
+
+        m_isRealizeDeferred = isRealizeDeferred || !isShown;
+        step();
+
+        if (m_framePlayedDelegate)
+        {
+            GAFPlaybackManager* manager = GAFPlaybackManager::getInstance();
+            if (manager->isDeferringCallbacks())
+            {
+                manager->queueFramePlayed(this, m_currentFrame);
+            }
+            else
             {
                 m_framePlayedDelegate(this, m_currentFrame);
             }
         }
     }
+    m_isRealizeDeferred = isRealizeDeferred;
+    return isFrameShown;
 }
 
-void GAFObject::pauseAnimation()
+void GAFObject::setLodLevels(const LodLevels_t& levels)
 {
-    if (m_isRunning)
+    m_lodLevels = levels;
+    m_lodLevelIndex = IDNONE;
+    m_lod = GAFLodLevel();
+}
+
+void GAFObject::updateLod()
+{
+    if (m_lodLevels.empty())
     {
-        setAnimationRunning(false, false);
+        return;
+    }
 
-        if (m_animationFinishedPlayDelegate)
+    const uint32_t lastLevel = static_cast<uint32_t>(m_lodLevels.size()) - 1;
+    uint32_t index = lastLevel;
+    if (m_lodSelectorDelegate)
+    {
+        index = std::min(m_lodSelectorDelegate(this), lastLevel);
+    }
+    else
+    {
+        const ax::AffineTransform t = getNodeToWorldAffineTransform();
+        const float scale = sqrtf(std::max(t.a * t.a + t.b * t.b, t.c * t.c + t.d * t.d));
+        for (uint32_t i = 0; i < lastLevel; ++i)
         {
-            m_animationFinishedPlayDelegate(this);
+            if (scale >= m_lodLevels[i].minScale)
+            {
+                index = i;
+                break;
+            }
         }
     }
+
+    if (index != m_lodLevelIndex)
+    {
+        m_lodLevelIndex = index;
+        m_lod = m_lodLevels[index];
+    }
+}
+
+void GAFObject::pauseAnimation()
+{
+    if (m_isRunning)
+    {
+        setAnimationRunning(false, false);
+        notifyFinishedPlay();
+    }
 }
 
 void GAFObject::resumeAnimation()
@@ -450,6 +617,7 @@ bool GAFObject::setFrame(uint32_t index)
 {
     if (index < m_totalFrameCount)
     {
+        markNestedChanged();
         m_showingFrame = m_currentFrame = index;
         processAnimation();
         return true;
@@ -457,12 +625,30 @@ bool GAFObject::setFrame(uint32_t index)
     return false;
 }
 
-bool GAFObject::gotoAndStop(const std::string& frameLabel)
+// Frame number in the label is 1-based like atoi parses it, 0 if the label is not a number
+static uint32_t parseFrameNumber(std::string_view frameLabel)
+{
+    size_t pos = frameLabel.find_first_not_of(" \t\n\v\f\r");
+    if (pos == std::string_view::npos)
+    {
+        return 0;
+    }
+    if (frameLabel[pos] == '+')
+    {
+        ++pos;
+    }
+
+    uint32_t frameNumber = 0;
+    std::from_chars(frameLabel.data() + pos, frameLabel.data() + frameLabel.size(), frameNumber);
+    return frameNumber;
+}
+
+bool GAFObject::gotoAndStop(std::string_view frameLabel)
 {
     uint32_t f = getStartFrame(frameLabel);
     if (IDNONE == f)
     {
-        uint32_t frameNumber = atoi(frameLabel.c_str());
+        uint32_t frameNumber = parseFrameNumber(frameLabel);
         if (frameNumber == 0)
         {
             return false;
@@ -477,23 +663,19 @@ bool GAFObject::gotoAndStop(uint32_t frameNumber)
     if (setFrame(frameNumber))
     {
         m_isRunning = false;
-
-        if (m_animationFinishedPlayDelegate)
-        {
-            m_animationFinishedPlayDelegate(this);
-        }
+        notifyFinishedPlay();
 
         return true;
     }
     return false;
 }
 
-bool GAFObject::gotoAndPlay(const std::string& frameLabel)
+bool GAFObject::gotoAndPlay(std::string_view frameLabel)
 {
     uint32_t f = getStartFrame(frameLabel);
     if (IDNONE == f)
     {
-        uint32_t frameNumber = atoi(frameLabel.c_str());
+        uint32_t frameNumber = parseFrameNumber(frameLabel);
         if (frameNumber == 0)
         {
             return false;
@@ -513,7 +695,266 @@ bool GAFObject::gotoAndPlay(uint32_t frameNumber)
     return false;
 }
 
-uint32_t GAFObject::getStartFrame(const std::string& frameLabel)
+void GAFObject::captureNestedPlayback(PlaybackStates_t& states) const
+{
+    for (const GAFObject* subObject : m_displayList)
+    {
+        if (!subObject || subObject->m_charType != GAFCharacterType::Timeline)
+        {
+            continue;
+        }
+
+        PlaybackState state;
+        state.currentFrame = subObject->m_currentFrame;
+        state.showingFrame = subObject->m_showingFrame;
+        state.lastRealizedFrame = subObject->m_lastRealizedFrame;
+        state.sequenceStart = subObject->m_currentSequenceStart;
+        state.sequenceEnd = subObject->m_currentSequenceEnd;
+        state.isRunning = subObject->m_isRunning;
+        state.isLooped = subObject->m_isLooped;
+        state.isReversed = subObject->m_isReversed;
+        state.isInResetState = subObject->m_isInResetState;
+        states.push_back(state);
+
+        subObject->captureNestedPlayback(states);
+    }
+}
+
+void GAFObject::restoreNestedPlayback(const PlaybackStates_t& states, size_t& index)
+{
+    for (GAFObject* subObject : m_displayList)
+    {
+        if (!subObject || subObject->m_charType != GAFCharacterType::Timeline)
+        {
+            continue;
+        }
+
+        AXASSERT(index < states.size(), "Error! Playback states do not match the display list");
+        const PlaybackState& state = states[index++];
+        subObject->m_currentFrame = state.currentFrame;
+        subObject->m_showingFrame = state.showingFrame;
+        subObject->m_lastRealizedFrame = state.lastRealizedFrame;
+        subObject->m_currentSequenceStart = state.sequenceStart;
+        subObject->m_currentSequenceEnd = state.sequenceEnd;
+        subObject->m_isRunning = state.isRunning;
+        subObject->m_isLooped = state.isLooped;
+        subObject->m_isReversed = state.isReversed;
+        subObject->m_isInResetState = state.isInResetState;
+
+        subObject->restoreNestedPlayback(states, index);
+    }
+}
+
+void GAFObject::resetNestedPlayback()
+{
+    for (GAFObject* subObject : m_displayList)
+    {
+        if (!subObject || subObject->m_charType != GAFCharacterType::Timeline)
+        {
+            continue;
+        }
+
+        subObject->m_currentFrame = subObject->m_isReversed ? subObject->m_currentSequenceEnd - 1 : subObject->m_currentSequenceStart;
+        subObject->m_showingFrame = subObject->m_currentFrame;
+        subObject->m_lastRealizedFrame = IDNONE;
+        subObject->m_isRunning = true;
+        subObject->m_isInResetState = false;
+
+        subObject->resetNestedPlayback();
+    }
+}
+
+uint32_t GAFObject::getSequenceFrame(uint32_t position) const
+{
+    return m_isReversed ? m_currentSequenceEnd - 1 - position : m_currentSequenceStart + position;
+}
+
+void GAFObject::notifyFinishedPlay()
+{
+    if (!m_animationFinishedPlayDelegate || isFastForwarding())
+    {
+        return;
+    }
+
+    GAFPlaybackManager* manager = GAFPlaybackManager::getInstance();
+    if (manager->isDeferringCallbacks())
+    {
+        manager->queueFinishedPlay(this);
+    }
+    else
+    {
+        m_animationFinishedPlayDelegate(this);
+    }
+}
+
+void GAFObject::dispatchEvent(const GAFTimelineAction& action)
+{
+    GAFPlaybackManager* manager = GAFPlaybackManager::getInstance();
+    if (manager->isDeferringCallbacks())
+    {
+        manager->queueEvent(this, &action);
+        return;
+    }
+
+    GAFEvent event;
+    event.id = action.getEventId();
+    event.object = this;
+    event.action = &action;
+
+    for (GAFObject* object = this; object; object = object->m_timelineParentObject)
+    {
+        if (object->m_eventListeners)
+        {
+            object->m_eventListeners->dispatch(event);
+        }
+    }
+
+    if (m_asset->m_eventListeners)
+    {
+        m_asset->m_eventListeners->dispatch(event);
+    }
+
+    if (m_asset->m_isEngineEventsEnabled)
+    {
+        _eventDispatcher->dispatchCustomEvent(action.getParam(GAFTimelineAction::PI_EVENT_TYPE), const_cast<GAFTimelineAction*>(&action));
+    }
+}
+
+uint32_t GAFObject::addEventListener(uint32_t eventId, const GAFEventDelegate_t& delegate)
+{
+    if (!m_eventListeners)
+    {
+        m_eventListeners = new GAFEventRegistry();
+    }
+    return m_eventListeners->addListener(eventId, delegate);
+}
+
+uint32_t GAFObject::addEventListener(std::string_view type, const GAFEventDelegate_t& delegate)
+{
+    return addEventListener(GAFEventRegistry::intern(type), delegate);
+}
+
+void GAFObject::removeEventListener(uint32_t handle)
+{
+    if (m_eventListeners)
+    {
+        m_eventListeners->removeListener(handle);
+    }
+}
+
+bool GAFObject::isFastForwarding() const
+{
+    for (const GAFObject* object = this; object; object = object->m_timelineParentObject)
+    {
+        if (object->m_isFastForwarding)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void GAFObject::seekStep(uint32_t position)
+{
+    m_showingFrame = m_currentFrame = getSequenceFrame(position);
+    advanceFrame(m_currentFrame, true);
+}
+
+void GAFObject::buildCheckpoints(uint32_t interval)
+{
+    AXASSERT(interval, "Error! Checkpoint interval is zero");
+    clearCheckpoints();
+    if (!interval || m_currentSequenceEnd <= m_currentSequenceStart)
+    {
+        return;
+    }
+
+    // Playback is simulated from the sequence start and put back as it was
+    PlaybackStates_t saved;
+    captureNestedPlayback(saved);
+    const uint32_t savedCurrentFrame = m_currentFrame;
+    const uint32_t savedShowingFrame = m_showingFrame;
+    const uint32_t savedLastRealizedFrame = m_lastRealizedFrame;
+
+    m_checkpointInterval = interval;
+    m_checkpointSequenceStart = m_currentSequenceStart;
+    m_checkpointSequenceEnd = m_currentSequenceEnd;
+    m_checkpointReversed = m_isReversed;
+
+    m_isFastForwarding = true;
+    m_lastRealizedFrame = IDNONE;
+    resetNestedPlayback();
+    for (uint32_t position = 0, length = m_currentSequenceEnd - m_currentSequenceStart; position < length; ++position)
+    {
+        seekStep(position);
+        if (position % interval == 0)
+        {
+            m_checkpoints.emplace_back();
+            captureNestedPlayback(m_checkpoints.back());
+        }
+    }
+    m_isFastForwarding = false;
+
+    size_t index = 0;
+    restoreNestedPlayback(saved, index);
+    m_currentFrame = savedCurrentFrame;
+    m_showingFrame = savedShowingFrame;
+    m_lastRealizedFrame = savedLastRealizedFrame;
+}
+
+void GAFObject::clearCheckpoints()
+{
+    m_checkpoints.clear();
+    m_checkpointInterval = 0;
+}
+
+bool GAFObject::hasCheckpoints() const
+{
+    return !m_checkpoints.empty() && m_checkpointSequenceStart == m_currentSequenceStart
+        && m_checkpointSequenceEnd == m_currentSequenceEnd && m_checkpointReversed == m_isReversed;
+}
+
+bool GAFObject::seekFrame(uint32_t frame)
+{
+    if (frame < m_currentSequenceStart || frame >= m_currentSequenceEnd)
+    {
+        return false;
+    }
+
+    const uint32_t target = m_isReversed ? m_currentSequenceEnd - 1 - frame : frame - m_currentSequenceStart;
+
+    m_isFastForwarding = true;
+    uint32_t position = 0;
+    if (hasCheckpoints())
+    {
+        position = std::min(target / m_checkpointInterval, static_cast<uint32_t>(m_checkpoints.size() - 1)) * m_checkpointInterval;
+        size_t index = 0;
+        restoreNestedPlayback(m_checkpoints[position / m_checkpointInterval], index);
+        m_lastRealizedFrame = getSequenceFrame(position);
+    }
+    else
+    {
+        m_lastRealizedFrame = IDNONE;
+        resetNestedPlayback();
+        seekStep(0);
+    }
+
+    while (position < target)
+    {
+        seekStep(++position);
+    }
+    m_isFastForwarding = false;
+
+    m_showingFrame = m_currentFrame = frame;
+    if (!m_isRealizeDeferred && !updateCulling())
+    {
+        evaluateFrame();
+        applyFrame(m_container);
+    }
+    return true;
+}
+
+uint32_t GAFObject::getStartFrame(std::string_view frameLabel)
 {
     if (!m_asset)
     {
@@ -529,7 +970,7 @@ uint32_t GAFObject::getStartFrame(const std::string& frameLabel)
 
 }
 
-uint32_t GAFObject::getEndFrame(const std::string& frameLabel)
+uint32_t GAFObject::getEndFrame(std::string_view frameLabel)
 {
     if (!m_asset)
     {
@@ -543,7 +984,7 @@ uint32_t GAFObject::getEndFrame(const std::string& frameLabel)
     return IDNONE;
 }
 
-bool GAFObject::playSequence(const std::string& name, bool looped, bool resume /*= true*/)
+bool GAFObject::playSequence(std::string_view name, bool looped, bool resume /*= true*/)
 {
     if (!m_asset || !m_timeline)
     {
@@ -555,8 +996,18 @@ bool GAFObject::playSequence(const std::string& name, bool looped, bool resume /
         return false;
     }
 
-    uint32_t s = getStartFrame(name);
-    uint32_t e = getEndFrame(name);
+    return playSequence(m_timeline->getSequence(name), looped, resume);
+}
+
+bool GAFObject::playSequence(const GAFAnimationSequence* sequence, bool looped, bool resume /*= true*/)
+{
+    if (!m_asset || !m_timeline || !sequence)
+    {
+        return false;
+    }
+
+    uint32_t s = sequence->startFrameNo;
+    uint32_t e = sequence->endFrameNo;
 
     if (IDNONE == s || IDNONE == e)
     {
@@ -595,11 +1046,18 @@ void GAFObject::step()
 
     if (!getIsAnimationRunning())
     {
-        processAnimation();
+        if (m_lastRealizedFrame == m_currentFrame)
+        {
+            refreshFrame();
+        }
+        else
+        {
+            processAnimation();
+        }
         return;
     }
 
-    if (m_sequenceDelegate && m_timeline)
+    if (m_sequenceDelegate && m_timeline && !isFastForwarding())
     {
         const GAFAnimationSequence * seq = nullptr;
         if (!m_isReversed)
@@ -613,7 +1071,15 @@ void GAFObject::step()
 
         if (seq)
         {
-            m_sequenceDelegate(this, seq->name);
+            GAFPlaybackManager* manager = GAFPlaybackManager::getInstance();
+            if (manager->isDeferringCallbacks())
+            {
+                manager->queueSequence(this, seq);
+            }
+            else
+            {
+                m_sequenceDelegate(this, seq->name);
+            }
         }
     }
 
@@ -621,15 +1087,19 @@ void GAFObject::step()
     {
         if (m_isLooped)
         {
-            if (m_animationStartedNextLoopDelegate)
-                m_animationStartedNextLoopDelegate(this);
+            if (m_animationStartedNextLoopDelegate && !isFastForwarding())
+            {
+                GAFPlaybackManager* manager = GAFPlaybackManager::getInstance();
+                if (manager->isDeferringCallbacks())
+                    manager->queueStartedNextLoop(this);
+                else
+                    m_animationStartedNextLoopDelegate(this);
+            }
         }
         else
         {
             setAnimationRunning(false, false);
-
-            if (m_animationFinishedPlayDelegate)
-                m_animationFinishedPlayDelegate(this);
+            notifyFinishedPlay();
         }
     }
 
@@ -679,72 +1149,77 @@ const AnimationSequences_t& GAFObject::getSequences() const
     return s_emptySequences;
 }
 
-static ax::Rect GAFCCRectUnion(const ax::Rect& src1, const ax::Rect& src2)
+ax::Rect GAFObject::getBoundingBoxForCurrentFrame()
 {
-    float thisLeftX = src1.origin.x;
-    float thisRightX = src1.origin.x + src1.size.width;
-    float thisTopY = src1.origin.y + src1.size.height;
-    float thisBottomY = src1.origin.y;
+    return ax::RectApplyTransform(getBoundsForFrame(m_showingFrame), getNodeToParentTransform());
+}
 
-    if (thisRightX < thisLeftX)
-    {
-        std::swap(thisRightX, thisLeftX); // This rect has negative width
-    }
+ax::Rect GAFObject::convertTimelineBounds(const ax::Rect& bounds) const
+{
+    // Same conversion realizeFrame applies to the content of the frame
+    ax::AffineTransform t = AffineTransformFlashToCocos(ax::AffineTransformMake(1, 0, 0, -1, 0, 0));
 
-    if (thisTopY < thisBottomY)
+    ax::AffineTransform flipCenterTransform;
+    if (getFlipTransform(flipCenterTransform))
     {
-        std::swap(thisTopY, thisBottomY); // This rect has negative height
+        t = AffineTransformConcat(t, flipCenterTransform);
     }
 
-    float otherLeftX = src2.origin.x;
-    float otherRightX = src2.origin.x + src2.size.width;
-    float otherTopY = src2.origin.y + src2.size.height;
-    float otherBottomY = src2.origin.y;
+    return ax::RectApplyAffineTransform(bounds, t);
+}
 
-    if (otherRightX < otherLeftX)
+bool GAFObject::getFlipTransform(ax::AffineTransform& flipCenterTransform) const
+{
+    if (!isFlippedX() && !isFlippedY())
     {
-        std::swap(otherRightX, otherLeftX); // Other rect has negative width
+        return false;
     }
 
-    if (otherTopY < otherBottomY)
-    {
-        std::swap(otherTopY, otherBottomY); // Other rect has negative height
-    }
+    float flipMulX = isFlippedX() ? -1 : 1;
+    float flipOffsetX = isFlippedX() ? getContentSize().width - m_asset->getHeader().frameSize.getMinX() : 0;
+    float flipMulY = isFlippedY() ? -1 : 1;
+    float flipOffsetY = isFlippedY() ? -getContentSize().height + m_asset->getHeader().frameSize.getMinY() : 0;
 
-    float combinedLeftX = std::min(thisLeftX, otherLeftX);
-    float combinedRightX = std::max(thisRightX, otherRightX);
-    float combinedTopY = std::max(thisTopY, otherTopY);
-    float combinedBottomY = std::min(thisBottomY, otherBottomY);
+    flipCenterTransform = ax::AffineTransformMake(flipMulX, 0, 0, flipMulY, flipOffsetX, flipOffsetY);
+    return true;
+}
 
-    return ax::Rect(combinedLeftX, combinedBottomY, combinedRightX - combinedLeftX, combinedTopY - combinedBottomY);
+ax::Rect GAFObject::getBoundsForFrame(uint32_t frame) const
+{
+    if (!m_timeline)
+    {
+        return ax::Rect::ZERO;
+    }
+    return convertTimelineBounds(m_timeline->getFrameBounds(frame));
 }
 
-ax::Rect GAFObject::getBoundingBoxForCurrentFrame()
+void GAFObject::getNestedFrames(GAFNestedFrames_t& frames) const
 {
-    ax::Rect result = ax::Rect::ZERO;
+    const AnimationFrames_t& animationFrames = m_timeline->getAnimationFrames();
+    if (m_lastRealizedFrame >= animationFrames.size())
+    {
+        return;
+    }
 
-    bool isFirstObj = true;
-    for (DisplayList_t::iterator i = m_displayList.begin(), e = m_displayList.end(); i != e; ++i)
+    for (const GAFSubobjectState* state : animationFrames[m_lastRealizedFrame]->getVisibleObjectStates())
     {
-        if (*i == nullptr)
+        const GAFObject* subObject = state->objectIdRef < m_displayList.size() ? m_displayList[state->objectIdRef] : nullptr;
+        if (subObject && subObject->m_charType == GAFCharacterType::Timeline)
         {
-            continue;
+            frames.push_back(subObject->m_lastRealizedFrame != IDNONE ? subObject->m_lastRealizedFrame : 0);
+            subObject->getNestedFrames(frames);
         }
-
-        GAFSprite* anim = *i;
-        if (anim->isVisible())
-        {
-            ax::Rect bb = anim->getBoundingBox();
-            if (isFirstObj)
-                result = bb;
-            else
-                result = GAFCCRectUnion(result, bb);
-        }
-
-        isFirstObj = false;
     }
+}
 
-    return ax::RectApplyTransform(result, getNodeToParentTransform());
+ax::Rect GAFObject::getBoundsForSequence(std::string_view name) const
+{
+    const GAFAnimationSequence* seq = m_timeline ? m_timeline->getSequence(name) : nullptr;
+    if (!seq)
+    {
+        return ax::Rect::ZERO;
+    }
+    return convertTimelineBounds(seq->bounds);
 }
 
 ax::Mat4 const& GAFObject::getNodeToParentTransform() const
@@ -766,12 +1241,14 @@ ax::AffineTransform GAFObject::getNodeToParentAffineTransform() const
 void GAFObject::setColor(const ax::Color3B& color)
 {
     m_isManualColor = true;
+    markNestedChanged();
     Node::setColor(color);
 }
 
 void GAFObject::setOpacity(uint8_t opacity)
 {
     m_isManualColor = true;
+    markNestedChanged();
     Node::setOpacity(opacity);
 }
 
@@ -791,91 +1268,588 @@ void GAFObject::rearrangeSubobject(ax::Node* out, ax::Node* child, int zIndex)
     }
 }
 
+void GAFObject::updateResetState(GAFObject* subObject, const GAFSubobjectState* state)
+{
+    if (state->colorMults()[GAFColorTransformIndex::GAFCTI_A] >= 0.f && subObject->m_isInResetState)
+    {
+        subObject->m_currentFrame = subObject->m_currentSequenceStart;
+    }
+    subObject->m_isInResetState = state->colorMults()[GAFColorTransformIndex::GAFCTI_A] < 0.f;
+}
+
+void GAFObject::updateStaticObjects(uint32_t first, uint32_t last)
+{
+    m_staticRangeFirst = first;
+    m_staticRangeLast = last;
+
+    m_staticObjects.assign(m_displayList.size(), false);
+    for (uint32_t id = 0; id < m_staticObjects.size(); ++id)
+    {
+        m_staticObjects[id] = m_timeline->isObjectStatic(id, first, last);
+    }
+    ++m_staticRevision;
+}
+
+bool GAFObject::isStaticInputsChanged() const
+{
+    const StaticInputs& in = m_staticInputs;
+    return !(in.parentColorTransforms[0] == m_parentColorTransforms[0]
+        && in.parentColorTransforms[1] == m_parentColorTransforms[1]
+        && in.parentFilters == m_parentFilters
+        && in.customFilter == m_customFilter
+        && in.displayedColor == _displayedColor
+        && in.displayedOpacity == _displayedOpacity
+        && in.contentSize.equals(getContentSize())
+        && in.anchorPoint == getAnchorPointInPoints()
+        && in.cameraMask == getCameraMask()
+        && in.flippedX == isFlippedX()
+        && in.flippedY == isFlippedY()
+        && in.filtersDisabled == m_lod.disableFilters);
+}
+
+bool GAFObject::updateStaticInputs()
+{
+    if (!isStaticInputsChanged())
+    {
+        return false;
+    }
+
+    StaticInputs& in = m_staticInputs;
+    const ax::Size& contentSize = getContentSize();
+    const ax::Vec2& anchorPoint = getAnchorPointInPoints();
+    in.parentColorTransforms[0] = m_parentColorTransforms[0];
+    in.parentColorTransforms[1] = m_parentColorTransforms[1];
+    in.parentFilters = m_parentFilters;
+    in.customFilter = m_customFilter;
+    in.displayedColor = _displayedColor;
+    in.displayedOpacity = _displayedOpacity;
+    in.contentSize = contentSize;
+    in.anchorPoint = anchorPoint;
+    in.cameraMask = getCameraMask();
+    in.flippedX = isFlippedX();
+    in.flippedY = isFlippedY();
+    in.filtersDisabled = m_lod.disableFilters;
+    return true;
+}
+
+bool GAFObject::isInStaticRange(uint32_t frameIndex) const
+{
+    return frameIndex != IDNONE && frameIndex >= m_staticRangeFirst && frameIndex <= m_staticRangeLast;
+}
+
+bool GAFObject::isEvaluationCurrent() const
+{
+    // Nested timelines frozen by LOD are not advanced, so their playing state changes nothing
+    return !m_isNestedChanged
+        && (!m_isNestedPlaying || m_lod.skipNestedTimelines)
+        && m_lastEvaluatedFrame == m_lastRealizedFrame
+        && m_appliedRevision == m_staticRevision
+        && m_appliedInterpolationFactor == 0.f
+        && (m_interpolationFactor == 0.f || !getIsAnimationRunning())
+        && !isStaticInputsChanged();
+}
+
+void GAFObject::markNestedChanged()
+{
+    for (GAFObject* parent = m_timelineParentObject; parent; parent = parent->m_timelineParentObject)
+    {
+        parent->m_isNestedChanged = true;
+    }
+}
+
 void GAFObject::realizeFrame(ax::Node* out, uint32_t frameIndex)
+{
+    if (!advanceFrame(frameIndex) || m_isRealizeDeferred || updateCulling())
+    {
+        return;
+    }
+
+    evaluateFrame();
+    applyFrame(out);
+}
+
+void GAFObject::refreshFrame()
+{
+    // Nothing is advanced or evaluated while refreshing would change no node of the subtree
+    if (isEvaluationCurrent())
+    {
+        return;
+    }
+
+    if (!advanceFrame(m_lastRealizedFrame, true) || m_isRealizeDeferred || updateCulling())
+    {
+        return;
+    }
+
+    evaluateFrame();
+    applyFrame(m_container);
+}
+
+bool GAFObject::advanceFrame(uint32_t frameIndex, bool isRefresh)
 {
     const AnimationFrames_t& animationFrames = m_timeline->getAnimationFrames();
 
     if (animationFrames.size() <= frameIndex)
     {
-        return;
+        return false;
     }
 
     GAFAnimationFrame *currentFrame = animationFrames[frameIndex];
 
-    const GAFAnimationFrame::SubobjectStates_t& states = currentFrame->getObjectStates();
+    // Invisible states matter only when they change the reset state of an object. Changes are known
+    // relative to the previous frame, so any jump walks through all states of the frame
+    const uint32_t lastRealizedFrame = m_lastRealizedFrame;
+    m_lastRealizedFrame = frameIndex;
+
+    const GAFAnimationFrame::SubobjectStates_t* states = &currentFrame->getObjectStates();
+    if (lastRealizedFrame == frameIndex)
+    {
+        states = &currentFrame->getVisibleObjectStates();
+    }
+    else if (lastRealizedFrame != IDNONE && (lastRealizedFrame + 1) % animationFrames.size() == frameIndex)
+    {
+        for (const GAFSubobjectState* state : currentFrame->getResetStateChanges())
+        {
+            GAFObject* subObject = m_displayList[state->objectIdRef];
+            if (subObject)
+            {
+                updateResetState(subObject, state);
+            }
+        }
+        states = &currentFrame->getVisibleObjectStates();
+    }
 
-    for (const GAFSubobjectState* state : states)
+    bool isNestedPlaying = false;
+    for (const GAFSubobjectState* state : *states)
     {
         GAFObject* subObject = m_displayList[state->objectIdRef];
 
         if (!subObject)
             continue;
 
-        if (state->colorMults()[GAFColorTransformIndex::GAFCTI_A] >= 0.f && subObject->m_isInResetState)
+        updateResetState(subObject, state);
+
+        // Nested timelines depend on the evaluated state of this frame, so they are evaluated along with it
+        if (state->isVisible() && subObject->m_charType == GAFCharacterType::Timeline && !subObject->m_isInResetState
+            && !m_lod.skipNestedTimelines)
+        {
+            subObject->m_lod = m_lod;
+            subObject->m_isRealizeDeferred = true;
+            subObject->step();
+            subObject->m_isRealizeDeferred = false;
+            isNestedPlaying = isNestedPlaying || subObject->m_isRunning || subObject->m_isNestedPlaying;
+        }
+    }
+    m_isNestedPlaying = isNestedPlaying;
+
+    // Actions run once when the frame is entered
+    if (isRefresh)
+    {
+        return true;
+    }
+
+    const GAFAnimationFrame::TimelineActions_t& timelineActions = currentFrame->getTimelineActions();
+    for (const GAFTimelineAction& action : timelineActions)
+    {
+        switch (action.getType())
+        {
+        case GAFActionType::Stop:
+            pauseAnimation();
+            break;
+        case GAFActionType::Play:
+            resumeAnimation();
+            break;
+        case GAFActionType::GotoAndStop:
+            gotoAndStop(action.getFrame());
+            break;
+        case GAFActionType::GotoAndPlay:
+            gotoAndPlay(action.getFrame());
+            break;
+        case GAFActionType::DispatchEvent:
+            if (isFastForwarding())
+            {
+                break;
+            }
+            if (action.isSoundEvent())
+            {
+                m_asset->soundEvent(&action);
+            }
+            else
+            {
+                dispatchEvent(action);
+            }
+            break;
+
+        case GAFActionType::None:
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+void GAFObject::evaluateFrame()
+{
+    m_isEvaluatedDirty = false;
+    m_isNestedChanged = false;
+
+    const uint32_t frameIndex = m_lastRealizedFrame;
+    const AnimationFrames_t& animationFrames = m_timeline->getAnimationFrames();
+
+    if (animationFrames.size() <= frameIndex)
+    {
+        m_evaluatedFrame = nullptr;
+        return;
+    }
+
+    const GAFAnimationFrame *currentFrame = animationFrames[frameIndex];
+    m_evaluatedFrame = currentFrame;
+
+    const uint32_t lastEvaluatedFrame = m_lastEvaluatedFrame;
+    m_lastEvaluatedFrame = frameIndex;
+
+    // Objects static over the playing range are applied once and skipped until something they depend on changes
+    const uint32_t staticRangeLast = m_currentSequenceEnd - 1;
+    if (m_staticRangeFirst != m_currentSequenceStart || m_staticRangeLast != staticRangeLast)
+    {
+        updateStaticObjects(m_currentSequenceStart, staticRangeLast);
+    }
+    // Interpolation blends the states towards the frame playback goes to next
+    const GAFAnimationFrame* nextFrame = nullptr;
+    if (m_interpolationFactor > 0.f && getIsAnimationRunning() && m_currentFrame != frameIndex && m_currentFrame < animationFrames.size())
+    {
+        nextFrame = animationFrames[m_currentFrame];
+        m_nextStates.assign(m_displayList.size(), nullptr);
+        for (const GAFSubobjectState* state : nextFrame->getVisibleObjectStates())
         {
-            subObject->m_currentFrame = subObject->m_currentSequenceStart;
+            if (state->objectIdRef < m_nextStates.size())
+            {
+                m_nextStates[state->objectIdRef] = state;
+            }
         }
-        subObject->m_isInResetState = state->colorMults()[GAFColorTransformIndex::GAFCTI_A] < 0.f;
+    }
+    const float interpolationFactor = nextFrame ? m_interpolationFactor : 0.f;
+
+    // The same frame with the same inputs makes every object static
+    m_isEvaluatedFrameChanged = frameIndex != lastEvaluatedFrame;
+    if (updateStaticInputs() || (m_isEvaluatedFrameChanged && (!isInStaticRange(frameIndex) || !isInStaticRange(lastEvaluatedFrame)))
+        || interpolationFactor != m_appliedInterpolationFactor)
+    {
+        ++m_staticRevision;
+    }
+    m_appliedInterpolationFactor = interpolationFactor;
+    m_isEvaluatedDirty = m_isEvaluatedFrameChanged || m_appliedRevision != m_staticRevision;
+
+    // State transforms are converted at load, only the instance dependent parts are left
+    const float anchorOffsetY = getAnchorPointInPoints().y * (isFlippedY() ? -2 : 2);
+    ax::AffineTransform flipCenterTransform = ax::AffineTransform::IDENTITY;
+    const bool isFlipped = getFlipTransform(flipCenterTransform);
+
+    // Objects playing the frame with the same inputs share the values of its states
+    GAFEvaluationCache* cache = nextFrame ? nullptr : m_timeline->getEvaluationCache();
+    const GAFAnimationFrame::SubobjectStates_t& states = currentFrame->getVisibleObjectStates();
+    const GAFEvaluationCache::Entry* entry = nullptr;
+    GAFEvaluationCache::Key cacheKey;
+    if (cache)
+    {
+        cacheKey.parentColorTransforms[0] = m_parentColorTransforms[0];
+        cacheKey.parentColorTransforms[1] = m_parentColorTransforms[1];
+        cacheKey.flipCenterTransform = flipCenterTransform;
+        // Filters are keyed by id, a filter allocated where a freed one was does not match its entries
+        const GAFFilterData* inheritedFilter = m_customFilter ? m_customFilter : (m_parentFilters.empty() ? nullptr : m_parentFilters.front());
+        cacheKey.inheritedFilterId = inheritedFilter ? inheritedFilter->getId() : 0;
+        cacheKey.anchorOffsetY = anchorOffsetY;
+        cacheKey.displayedColor = _displayedColor;
+        cacheKey.displayedOpacity = _displayedOpacity;
+        cacheKey.isFlipped = isFlipped;
+        cacheKey.filtersDisabled = m_lod.disableFilters;
+
+        entry = cache->find(frameIndex, cacheKey);
+    }
 
-        if (!state->isVisible())
+    if (!entry)
+    {
+        evaluateStates(states, nextFrame, interpolationFactor, !cache, anchorOffsetY, isFlipped ? &flipCenterTransform : nullptr);
+        if (cache)
+        {
+            entry = cache->store(frameIndex, cacheKey, m_values, m_nestedStates);
+        }
+    }
+
+    setEvaluatedEntry(entry);
+    m_evaluatedValues = entry ? entry->values.data() : m_values.data();
+    m_evaluatedNestedStates = entry ? &entry->nestedStates : &m_nestedStates;
+
+    // Nested timelines get their inputs from the states of this frame
+    for (uint32_t i : *m_evaluatedNestedStates)
+    {
+        const GAFSubobjectState* state = states[i];
+        GAFObject* subObject = m_displayList[state->objectIdRef];
+
+        if (!isStateStatic(state, subObject))
+        {
+            subObject->m_parentFilters.clear();
+            if (m_customFilter)
+            {
+                subObject->m_parentFilters.push_back(m_customFilter);
+            }
+
+            const Filters_t& filters = state->getFilters();
+            subObject->m_parentFilters.insert(subObject->m_parentFilters.end(), filters.begin(), filters.end());
+
+            float cm[4];
+            float co[4];
+            getStateColors(state, getNextState(state, nextFrame), interpolationFactor, cm, co);
+            subObject->m_parentColorTransforms[0] = ax::Vec4(
+                m_parentColorTransforms[0].x * cm[0],
+                m_parentColorTransforms[0].y * cm[1],
+                m_parentColorTransforms[0].z * cm[2],
+                m_parentColorTransforms[0].w * cm[3]);
+            subObject->m_parentColorTransforms[1] = ax::Vec4(co) + m_parentColorTransforms[1];
+        }
+
+        if (subObject->m_isInResetState)
             continue;
 
-        if (subObject->m_charType == GAFCharacterType::Timeline)
+        subObject->m_lod = m_lod;
+        subObject->m_interpolationFactor = m_interpolationFactor;
+
+        // Nested timelines not advanced since their evaluation, e.g. frozen by LOD, keep their nodes
+        if (subObject->isEvaluationCurrent())
         {
-            if (!subObject->m_isInResetState)
+            subObject->m_isEvaluatedDirty = false;
+            continue;
+        }
+
+        subObject->evaluateFrame();
+        m_isEvaluatedDirty = m_isEvaluatedDirty || subObject->m_isEvaluatedDirty;
+    }
+}
+
+const GAFSubobjectState* GAFObject::getNextState(const GAFSubobjectState* state, const GAFAnimationFrame* nextFrame) const
+{
+    const GAFSubobjectState* next = nextFrame ? m_nextStates[state->objectIdRef] : nullptr;
+
+    // Display list changes snap to the frame
+    if (next && (next == state || next->zIndex != state->zIndex || next->maskObjectIdRef != state->maskObjectIdRef))
+    {
+        return nullptr;
+    }
+    return next;
+}
+
+bool GAFObject::isStateStatic(const GAFSubobjectState* state, const GAFObject* subObject) const
+{
+    return subObject->m_appliedStaticRevision == m_staticRevision
+        && (!m_isEvaluatedFrameChanged || m_staticObjects[state->objectIdRef]);
+}
+
+static float interpolate(float from, float to, float factor)
+{
+    return from + (to - from) * factor;
+}
+
+void GAFObject::getStateColors(const GAFSubobjectState* state, const GAFSubobjectState* next, float factor, float* colorMults, float* colorOffsets)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        colorMults[i] = next ? interpolate(state->colorMults()[i], next->colorMults()[i], factor) : state->colorMults()[i];
+        colorOffsets[i] = next ? interpolate(state->colorOffsets()[i], next->colorOffsets()[i], factor) : state->colorOffsets()[i];
+    }
+}
+
+void GAFObject::evaluateStates(const GAFAnimationFrame::SubobjectStates_t& states, const GAFAnimationFrame* nextFrame, float factor,
+    bool skipStatic, float anchorOffsetY, const ax::AffineTransform* flipCenterTransform)
+{
+    m_values.resize(states.size());
+    m_nestedStates.clear();
+
+    // States are gathered with textures and text fields first, only they are flipped around the center
+    m_batchStates.clear();
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (uint32_t i = 0, count = static_cast<uint32_t>(states.size()); i < count; ++i)
+        {
+            const GAFSubobjectState* state = states[i];
+            const GAFObject* subObject = m_displayList[state->objectIdRef];
+
+            if (!subObject || (subObject->m_charType == GAFCharacterType::Timeline) != (pass == 1))
+                continue;
+
+            if (pass == 1)
+            {
+                m_nestedStates.push_back(i);
+            }
+
+            // Static objects are not applied, so they need no values unless the values are shared
+            if (!skipStatic || !isStateStatic(state, subObject))
             {
-                ax::AffineTransform stateTransform = state->affineTransform;
-                float csf = m_timeline->usedAtlasScale();
-                stateTransform.tx *= csf;
-                stateTransform.ty *= csf;
-                ax::AffineTransform t = AffineTransformFlashToCocos(stateTransform);
+                m_batchStates.push_back(i);
+            }
+        }
+        if (pass == 0)
+        {
+            m_batchFlippedCount = m_batchStates.size();
+        }
+    }
+
+    const size_t count = m_batchStates.size();
+    const size_t flippedCount = m_batchFlippedCount;
+    m_batchScratch.resize(count * 14);
+    float* p = m_batchScratch.data();
+    const GAFTransformsSoA transforms = { p, p + count, p + count * 2, p + count * 3, p + count * 4, p + count * 5 };
+    GAFColorsSoA colors;
+    for (int ch = 0; ch < 4; ++ch)
+    {
+        colors.mults[ch] = p + count * (6 + ch);
+        colors.offsets[ch] = p + count * (10 + ch);
+    }
+
+    for (size_t j = 0; j < count; ++j)
+    {
+        const GAFSubobjectState* state = states[m_batchStates[j]];
+        const GAFSubobjectState* next = getNextState(state, nextFrame);
+
+        // Components are blended linearly, which is close enough for the small changes between adjacent frames
+        const ax::AffineTransform& from = state->cocosTransform;
+        const ax::AffineTransform& to = next ? next->cocosTransform : from;
+        const float f = next ? factor : 0.f;
+        transforms.a[j] = interpolate(from.a, to.a, f);
+        transforms.b[j] = interpolate(from.b, to.b, f);
+        transforms.c[j] = interpolate(from.c, to.c, f);
+        transforms.d[j] = interpolate(from.d, to.d, f);
+        transforms.tx[j] = interpolate(from.tx, to.tx, f);
+        transforms.ty[j] = interpolate(from.ty, to.ty, f);
+
+        float cm[4];
+        float co[4];
+        getStateColors(state, next, factor, cm, co);
+        for (int ch = 0; ch < 4; ++ch)
+        {
+            colors.mults[ch][j] = cm[ch];
+            colors.offsets[ch][j] = co[ch];
+        }
+    }
+
+    // Anchor offset and flip are composed as one parent transform of the whole batch
+    const ax::AffineTransform anchorTransform = ax::AffineTransformMake(1.f, 0.f, 0.f, 1.f, 0.f, anchorOffsetY);
+    const ax::AffineTransform flippedTransform = flipCenterTransform
+        ? ax::AffineTransformConcat(anchorTransform, *flipCenterTransform) : anchorTransform;
+    const GAFTransformsSoA nestedTransforms = { transforms.a + flippedCount, transforms.b + flippedCount, transforms.c + flippedCount,
+        transforms.d + flippedCount, transforms.tx + flippedCount, transforms.ty + flippedCount };
+    GAFKernels::concatTransforms(transforms, flippedTransform, transforms, flippedCount);
+    GAFKernels::concatTransforms(nestedTransforms, anchorTransform, nestedTransforms, count - flippedCount);
+
+    const float parentMults[4] = {
+        m_parentColorTransforms[0].x * _displayedColor.r / 255,
+        m_parentColorTransforms[0].y * _displayedColor.g / 255,
+        m_parentColorTransforms[0].z * _displayedColor.b / 255,
+        m_parentColorTransforms[0].w * _displayedOpacity / 255 };
+    const float parentOffsets[4] = { m_parentColorTransforms[1].x, m_parentColorTransforms[1].y,
+        m_parentColorTransforms[1].z, m_parentColorTransforms[1].w };
+    GAFKernels::composeColorTransforms(colors, parentMults, parentOffsets, colors, count);
+
+    for (size_t j = 0; j < count; ++j)
+    {
+        const GAFSubobjectState* state = states[m_batchStates[j]];
+        GAFEvaluatedValue& value = m_values[m_batchStates[j]];
+        value.transform = ax::AffineTransformMake(transforms.a[j], transforms.b[j], transforms.c[j], transforms.d[j],
+            transforms.tx[j], transforms.ty[j]);
+        value.filter = getStateFilter(state, m_displayList[state->objectIdRef]);
+        for (int ch = 0; ch < 4; ++ch)
+        {
+            value.colorMults[ch] = colors.mults[ch][j];
+            value.colorOffsets[ch] = colors.offsets[ch][j];
+        }
+    }
+}
+
+void GAFObject::setEvaluatedEntry(const GAFEvaluationCache::Entry* entry)
+{
+    if (entry == m_evaluatedEntry)
+    {
+        return;
+    }
+
+    if (entry)
+    {
+        entry->acquire();
+    }
+    if (m_evaluatedEntry)
+    {
+        m_evaluatedEntry->release();
+    }
+    m_evaluatedEntry = entry;
+}
+
+GAFFilterData* GAFObject::getStateFilter(const GAFSubobjectState* state, const GAFObject* subObject) const
+{
+#if ENABLE_RUNTIME_FILTERS
+    if (subObject->m_objectType == GAFObjectType::MovieClip && !m_lod.disableFilters)
+    {
+        if (m_customFilter)
+        {
+            return m_customFilter;
+        }
+        if (!m_parentFilters.empty())
+        {
+            return *m_parentFilters.begin();
+        }
 
+        const Filters_t& filters = state->getFilters();
+        if (!filters.empty())
+        {
+            return *filters.begin();
+        }
+    }
+#else
+    (void)state;
+    (void)subObject;
+#endif
+    return nullptr;
+}
+
+void GAFObject::applyFrame(ax::Node* out)
+{
+    if (!m_isEvaluatedDirty || !m_evaluatedFrame)
+    {
+        return;
+    }
+    m_isEvaluatedDirty = false;
+    m_appliedRevision = m_staticRevision;
+
+    const GAFAnimationFrame::SubobjectStates_t& states = m_evaluatedFrame->getVisibleObjectStates();
+    for (size_t i = 0, count = states.size(); i < count; ++i)
+    {
+        const GAFSubobjectState* state = states[i];
+        GAFObject* subObject = m_displayList[state->objectIdRef];
+
+        if (!subObject)
+            continue;
+
+        const GAFEvaluatedValue& value = m_evaluatedValues[i];
+        const bool isStatic = isStateStatic(state, subObject);
+        subObject->m_appliedStaticRevision = m_staticRevision;
+
+        // Subobject scale belongs to the instance, so it is applied to the shared values here
+        if (subObject->m_charType == GAFCharacterType::Timeline)
+        {
+            if (subObject->m_isInResetState)
+                continue;
+
+            if (!isStatic)
+            {
+                ax::AffineTransform t = value.transform;
                 t.tx /= subObject->getScaleX();
                 t.ty /= subObject->getScaleY();
-                
                 subObject->setAdditionalTransform(t);
-                
-                subObject->m_parentFilters.clear();
-                if (m_customFilter)
-                {
-                    subObject->m_parentFilters.push_back(m_customFilter);
-                }
-
-                const Filters_t& filters = state->getFilters();
-                subObject->m_parentFilters.insert(subObject->m_parentFilters.end(), filters.begin(), filters.end());
-                
-                const float* cm = state->colorMults();
-                subObject->m_parentColorTransforms[0] = ax::Vec4(
-                    m_parentColorTransforms[0].x * cm[0],
-                    m_parentColorTransforms[0].y * cm[1],
-                    m_parentColorTransforms[0].z * cm[2],
-                    m_parentColorTransforms[0].w * cm[3]);
-                subObject->m_parentColorTransforms[1] = ax::Vec4(state->colorOffsets()) + m_parentColorTransforms[1];
-
-                if (m_masks[state->objectIdRef])
-                {
-                    rearrangeSubobject(out, m_masks[state->objectIdRef], state->zIndex);
-                }
-                else
-                {
-                    //subObject->removeFromParentAndCleanup(false);
-                    if (state->maskObjectIdRef == IDNONE)
-                    {
-                        rearrangeSubobject(out, subObject, state->zIndex);
-                    }
-                    else
-                    {
-                        // If the state has a mask, then attach it 
-                        // to the clipping node. Clipping node will be attached on its state
-                        auto mask = m_masks[state->maskObjectIdRef];
-                        AXASSERT(mask, "Error. No mask found for this ID");
-                        if (mask)
-                            rearrangeSubobject(mask, subObject, state->zIndex);
-                    }
-                }
-
-                subObject->step();
+                attachSubobject(out, state, subObject);
             }
+            subObject->applyFrame(subObject->m_container);
+        }
+        else if (isStatic)
+        {
+            continue;
         }
         else if (subObject->m_charType == GAFCharacterType::Texture)
         {
@@ -886,24 +1860,10 @@ void GAFObject::realizeFrame(ax::Node* out, uint32_t frameIndex)
             if (subObject->m_objectType == GAFObjectType::MovieClip)
             {
                 // Validate sprite type (w/ or w/o filter)
-                const Filters_t& filters = state->getFilters();
-                GAFFilterData* filter = NULL;
+                GAFFilterData* filter = value.filter;
 
                 GAFMovieClip* mc = static_cast<GAFMovieClip*>(subObject);
 
-                if (m_customFilter)
-                {
-                    filter = m_customFilter;
-                }
-                else if (!m_parentFilters.empty())
-                {
-                    filter = *m_parentFilters.begin();
-                }
-                else if (!filters.empty())
-                {
-                    filter = *filters.begin();
-                }
-
                 if (filter)
                 {
                     filter->apply(mc);
@@ -936,139 +1896,125 @@ void GAFObject::realizeFrame(ax::Node* out, uint32_t frameIndex)
                 ((prevAP.y - 0.5f) * prevCS.height) / newCS.height + 0.5f);
             subObject->setAnchorPoint(newAP);
 
+            attachSubobject(out, state, subObject);
 
-            if (m_masks[state->objectIdRef])
-            {
-                rearrangeSubobject(out, m_masks[state->objectIdRef], state->zIndex);
-            }
-            else
-            {
-                //subObject->removeFromParentAndCleanup(false);
-                if (state->maskObjectIdRef == IDNONE)
-                {
-                    rearrangeSubobject(out, subObject, state->zIndex);
-                }
-                else
-                {
-                    // If the state has a mask, then attach it 
-                    // to the clipping node. Clipping node will be attached on its state
-                    auto mask = m_masks[state->maskObjectIdRef];
-                    AXASSERT(mask, "Error. No mask found for this ID");
-                    if (mask)
-                        rearrangeSubobject(mask, subObject, state->zIndex);
-                }
-            }
-
-            ax::AffineTransform stateTransform = state->affineTransform;
-            float csf = m_timeline->usedAtlasScale();
-            stateTransform.tx *= csf;
-            stateTransform.ty *= csf;
-            ax::AffineTransform t = AffineTransformFlashToCocos(state->affineTransform);
-            
-            if (isFlippedX() || isFlippedY())
-            {
-                float flipMulX = isFlippedX() ? -1 : 1;
-                float flipOffsetX = isFlippedX() ? getContentSize().width - m_asset->getHeader().frameSize.getMinX() : 0;
-                float flipMulY = isFlippedY() ? -1 : 1;
-                float flipOffsetY = isFlippedY() ? -getContentSize().height + m_asset->getHeader().frameSize.getMinY() : 0;
-
-                ax::AffineTransform flipCenterTransform = ax::AffineTransformMake(flipMulX, 0, 0, flipMulY, flipOffsetX, flipOffsetY);
-                t = AffineTransformConcat(t, flipCenterTransform);
-            }
-
+            ax::AffineTransform t = value.transform;
             float curScale = subObject->getScale();
             if (fabs(curScale - 1.0) > std::numeric_limits<float>::epsilon())
             {
                 t.a *= curScale;
                 t.d *= curScale;
             }
-
             subObject->setExternalTransform(t);
 
             if (subObject->m_objectType == GAFObjectType::MovieClip)
             {
                 GAFMovieClip* mc = static_cast<GAFMovieClip*>(subObject);
-                float colorMults[4] = {
-                    state->colorMults()[0] * m_parentColorTransforms[0].x * _displayedColor.r / 255,
-                    state->colorMults()[1] * m_parentColorTransforms[0].y * _displayedColor.g / 255,
-                    state->colorMults()[2] * m_parentColorTransforms[0].z * _displayedColor.b / 255,
-                    state->colorMults()[3] * m_parentColorTransforms[0].w * _displayedOpacity / 255
-                };
-                float colorOffsets[4] = {
-                    state->colorOffsets()[0] + m_parentColorTransforms[1].x,
-                    state->colorOffsets()[1] + m_parentColorTransforms[1].y,
-                    state->colorOffsets()[2] + m_parentColorTransforms[1].z,
-                    state->colorOffsets()[3] + m_parentColorTransforms[1].w
-                };
-
-                mc->setColorTransform(colorMults, colorOffsets);
+                mc->setColorTransform(value.colorMults, value.colorOffsets);
             }
         }
         else if (subObject->m_charType == GAFCharacterType::TextField)
         {
             //GAFTextField *tf = static_cast<GAFTextField*>(subObject);
             rearrangeSubobject(out, subObject, state->zIndex);
+            subObject->setExternalTransform(value.transform);
+        }
+    }
+}
 
-            ax::AffineTransform stateTransform = state->affineTransform;
-            float csf = m_timeline->usedAtlasScale();
-            stateTransform.tx *= csf;
-            stateTransform.ty *= csf;
-            ax::AffineTransform t = AffineTransformFlashToCocos(state->affineTransform);
+bool GAFObject::updateCulling()
+{
+    if (!m_isCullingEnabled || m_timelineParentObject)
+    {
+        m_isCulled = false;
+        return false;
+    }
 
-            if (isFlippedX() || isFlippedY())
-            {
-                float flipMulX = isFlippedX() ? -1 : 1;
-                float flipOffsetX = isFlippedX() ? getContentSize().width - m_asset->getHeader().frameSize.getMinX() : 0;
-                float flipMulY = isFlippedY() ? -1 : 1;
-                float flipOffsetY = isFlippedY() ? -getContentSize().height + m_asset->getHeader().frameSize.getMinY() : 0;
+    // Decided once per tick, ticks may advance the object several times
+    const unsigned int tick = ax::Director::getInstance()->getTotalFrames();
+    if (m_culledTick == tick)
+    {
+        return m_isCulled;
+    }
+    m_culledTick = tick;
 
-                ax::AffineTransform flipCenterTransform = ax::AffineTransformMake(flipMulX, 0, 0, flipMulY, flipOffsetX, flipOffsetY);
-                t = AffineTransformConcat(t, flipCenterTransform);
+    // Culled only when no camera drawing the object sees it
+    ax::Scene* scene = getScene();
+    bool isCulled = scene != nullptr;
+    if (scene)
+    {
+        const ax::Mat4 transform = getNodeToWorldTransform();
+        for (const ax::Camera* camera : scene->getCameras())
+        {
+            if (camera->isVisible() && (static_cast<unsigned short>(camera->getCameraFlag()) & getCameraMask())
+                && !isOutsideCamera(camera, transform))
+            {
+                isCulled = false;
+                break;
             }
-
-            subObject->setExternalTransform(t);
         }
+    }
 
-        if (state->isVisible())
-        {
-            subObject->m_lastVisibleInFrame = frameIndex + 1;
-        }
+    m_isCulled = isCulled;
+    if (m_isCulled)
+    {
+        // Nodes fall behind while culled, so the whole frame is applied when the object is back
+        m_lastEvaluatedFrame = IDNONE;
     }
+    return m_isCulled;
+}
 
-    GAFAnimationFrame::TimelineActions_t timelineActions = currentFrame->getTimelineActions();
-    for (GAFTimelineAction action : timelineActions)
+bool GAFObject::isOutsideCamera(const ax::Camera* camera, const ax::Mat4& transform) const
+{
+    const ax::Rect bounds = getBoundsForFrame(m_lastRealizedFrame);
+    const ax::Vec2 corners[4] = {
+        ax::Vec2(bounds.getMinX(), bounds.getMinY()),
+        ax::Vec2(bounds.getMaxX(), bounds.getMinY()),
+        ax::Vec2(bounds.getMaxX(), bounds.getMaxY()),
+        ax::Vec2(bounds.getMinX(), bounds.getMaxY()) };
+
+    // Corners are projected by the camera to the screen, so camera moves and zoom are accounted
+    float minX = std::numeric_limits<float>::max();
+    float minY = std::numeric_limits<float>::max();
+    float maxX = -std::numeric_limits<float>::max();
+    float maxY = -std::numeric_limits<float>::max();
+    for (const ax::Vec2& corner : corners)
     {
-        switch (action.getType())
-        {
-        case GAFActionType::Stop:
-            pauseAnimation();
-            break;
-        case GAFActionType::Play:
-            resumeAnimation();
-            break;
-        case GAFActionType::GotoAndStop:
-            gotoAndStop(action.getParam(GAFTimelineAction::PI_FRAME));
-            break;
-        case GAFActionType::GotoAndPlay:
-            gotoAndPlay(action.getParam(GAFTimelineAction::PI_FRAME));
-            break;
-        case GAFActionType::DispatchEvent:
-            {
-                std::string type = action.getParam(GAFTimelineAction::PI_EVENT_TYPE);
-                if (type.compare(GAFSoundInfo::SoundEvent) == 0)
-                {
-                    m_asset->soundEvent(&action);
-                }
-                else
-                {
-                    _eventDispatcher->dispatchCustomEvent(action.getParam(GAFTimelineAction::PI_EVENT_TYPE), &action);
-                }
-            }
-            break;
+        ax::Vec3 point(corner.x, corner.y, 0.f);
+        transform.transformPoint(&point);
+        const ax::Vec2 screenPoint = camera->projectGL(point);
+        minX = std::min(minX, screenPoint.x);
+        minY = std::min(minY, screenPoint.y);
+        maxX = std::max(maxX, screenPoint.x);
+        maxY = std::max(maxY, screenPoint.y);
+    }
 
-        case GAFActionType::None:
-        default:
-            break;
+    const ax::Director* director = ax::Director::getInstance();
+    const ax::Rect visibleRect(director->getVisibleOrigin(), director->getVisibleSize());
+    return !visibleRect.intersectsRect(ax::Rect(minX, minY, maxX - minX, maxY - minY));
+}
+
+void GAFObject::attachSubobject(ax::Node* out, const GAFSubobjectState* state, GAFObject* subObject)
+{
+    if (m_masks[state->objectIdRef])
+    {
+        rearrangeSubobject(out, m_masks[state->objectIdRef], state->zIndex);
+    }
+    else
+    {
+        //subObject->removeFromParentAndCleanup(false);
+        if (state->maskObjectIdRef == IDNONE)
+        {
+            rearrangeSubobject(out, subObject, state->zIndex);
+        }
+        else
+        {
+            // If the state has a mask, then attach it 
+            // to the clipping node. Clipping node will be attached on its state
+            auto mask = m_masks[state->maskObjectIdRef];
+            AXASSERT(mask, "Error. No mask found for this ID");
+            if (mask)
+                rearrangeSubobject(mask, subObject, state->zIndex);
         }
     }
 }
@@ -1082,6 +2028,7 @@ void GAFObject::setFps(uint32_t value)
 {
     AXASSERT(value, "Error! Fps is set to zero.");
     m_fps = value;
+    GAFPlaybackManager::getInstance()->updateFps(this);
 }
 
 void GAFObject::setFpsLimitations(bool fpsLimitations)
@@ -1089,81 +2036,165 @@ void GAFObject::setFpsLimitations(bool fpsLimitations)
     m_skipFpsCheck = !fpsLimitations;
 }
 
-GAFObject* GAFObject::getObjectByName(const std::string& name)
+void GAFObject::setCatchUpEnabled(bool enabled)
+{
+    m_isCatchUpEnabled = enabled;
+}
+
+bool GAFObject::isCatchUpEnabled() const
+{
+    return m_isCatchUpEnabled;
+}
+
+void GAFObject::setCullingEnabled(bool enabled)
+{
+    m_isCullingEnabled = enabled;
+    m_culledTick = UINT_MAX;
+    if (!enabled && m_isCulled)
+    {
+        m_isCulled = false;
+        evaluateFrame();
+        applyFrame(m_container);
+    }
+}
+
+bool GAFObject::isCullingEnabled() const
+{
+    return m_isCullingEnabled;
+}
+
+void GAFObject::setInterpolationEnabled(bool enabled)
+{
+    m_isInterpolationEnabled = enabled;
+    if (!enabled)
+    {
+        m_interpolationFactor = 0.f;
+    }
+}
+
+bool GAFObject::isInterpolationEnabled() const
+{
+    return m_isInterpolationEnabled;
+}
+
+GAFObject* GAFObject::getObjectByName(std::string_view name)
 {
     if (name.empty())
     {
         return nullptr;
     }
 
-    std::stringstream ss(name);
-    std::string item;
-    typedef std::vector<std::string> StringVec_t;
-    StringVec_t elems;
-    while (std::getline(ss, item, '.'))
+    GAFObject* retval = this;
+    size_t partStart = 0;
+
+    while (retval && retval->m_timeline)
     {
-        elems.push_back(item);
+        size_t partEnd = name.find('.', partStart);
+        std::string_view part = name.substr(partStart, partEnd == std::string_view::npos ? partEnd : partEnd - partStart);
+
+        uint32_t objectId = retval->m_timeline->getNamedPartId(part);
+        if (objectId >= retval->m_displayList.size())
+        {
+            // It is better to return nil instead of the last found object in a chain
+            return nullptr;
+        }
+
+        retval = retval->m_displayList[objectId];
+
+        if (partEnd == std::string_view::npos)
+        {
+            return retval;
+        }
+        partStart = partEnd + 1;
     }
+    return nullptr;
+}
 
-    GAFObject* retval = nullptr;
+const GAFObject* GAFObject::getObjectByName(std::string_view name) const
+{
+    return const_cast<GAFObject*>(this)->getObjectByName(name);
+}
 
-    if (!elems.empty())
+ObjectPath_t GAFObject::resolvePath(std::string_view name) const
+{
+    ObjectPath_t path;
+    if (name.empty())
+    {
+        return path;
+    }
+
+    const GAFObject* object = this;
+    size_t partStart = 0;
+
+    while (object && object->m_timeline)
     {
-        const NamedParts_t& np = m_timeline->getNamedParts();
-        NamedParts_t::const_iterator it = np.find(elems[0]);
+        size_t partEnd = name.find('.', partStart);
+        std::string_view part = name.substr(partStart, partEnd == std::string_view::npos ? partEnd : partEnd - partStart);
 
-        if (it != np.end())
+        uint32_t objectId = object->m_timeline->getNamedPartId(part);
+        if (objectId >= object->m_displayList.size())
         {
-            retval = m_displayList[it->second];
+            break;
+        }
 
-            if (elems.size() == 1)
-            {
-                return retval;
-            }
-            StringVec_t::iterator begIt = elems.begin() + 1;
+        path.push_back(objectId);
+        object = object->m_displayList[objectId];
 
-            while (begIt != elems.end())
-            {
-                const NamedParts_t& np = retval->m_timeline->getNamedParts();
-                NamedParts_t::const_iterator it = np.find(*begIt);
-                if (it != np.end())
-                {
-                    retval = retval->m_displayList[it->second];
-                }
-                else
-                {
-                    // Sequence is incorrect
-                    //break;
+        if (partEnd == std::string_view::npos)
+        {
+            return path;
+        }
+        partStart = partEnd + 1;
+    }
 
-                    // It is better to return nil instead of the last found object in a chain
-                    return nullptr;
-                }
+    path.clear();
+    return path;
+}
 
-                ++begIt;
-            }
+GAFObject* GAFObject::getObjectByPath(const ObjectPath_t& path)
+{
+    if (path.empty())
+    {
+        return nullptr;
+    }
 
-            return retval;
+    GAFObject* retval = this;
+    for (uint32_t objectId : path)
+    {
+        if (!retval || objectId >= retval->m_displayList.size())
+        {
+            return nullptr;
         }
+        retval = retval->m_displayList[objectId];
     }
-    return nullptr;
+    return retval;
 }
 
-const GAFObject* GAFObject::getObjectByName(const std::string& name) const
+const GAFObject* GAFObject::getObjectByPath(const ObjectPath_t& path) const
 {
-    return const_cast<GAFObject*>(this)->getObjectByName(name);
+    return const_cast<GAFObject*>(this)->getObjectByPath(path);
 }
 
 bool GAFObject::isVisibleInCurrentFrame() const
 {
-    // If sprite is a part of timeline object - check it for visibility in current frame
-    if (m_timelineParentObject && (m_timelineParentObject->getCurrentFrameIndex() + 1 != m_lastVisibleInFrame))
-        return false;
+    // If sprite is a part of timeline object - check it for visibility in the frame its node is applied with
+    if (m_timelineParentObject)
+    {
+        const GAFAnimationFrame* frame = m_timelineParentObject->m_evaluatedFrame;
+        return frame && frame->isObjectVisible(objectIdRef);
+    }
     return true;
 }
 
 void GAFObject::visit(ax::Renderer *renderer, const ax::Mat4 &transform, uint32_t flags)
 {
-    if (isVisibleInCurrentFrame())
+    if (!isVisibleInCurrentFrame())
+    {
+        return;
+    }
+
+    // Culling is decided on ticks, the children are not changed while the scene is drawn
+    if (!m_isCulled)
     {
         GAFSprite::visit(renderer, transform, flags);
     }
@@ -1171,18 +2202,28 @@ void GAFObject::visit(ax::Renderer *renderer, const ax::Mat4 &transform, uint32_
 
 void GAFObject::enableTick(bool val)
 {
-    if (!m_animationsSelectorScheduled && val)
+    // Playback manager ignores repeated adds and removes
+    if (val)
     {
-        schedule(ax::SEL_SCHEDULE(&GAFObject::processAnimations));
-
-        m_animationsSelectorScheduled = true;
+        GAFPlaybackManager::getInstance()->add(this);
     }
-    else if (m_animationsSelectorScheduled && !val)
+    else
     {
-        unschedule(ax::SEL_SCHEDULE(&GAFObject::processAnimations));
-
-        m_animationsSelectorScheduled = false;
+        GAFPlaybackManager::getInstance()->remove(this);
     }
+    m_animationsSelectorScheduled = val;
+}
+
+void GAFObject::pause()
+{
+    GAFSprite::pause();
+    m_isTickPaused = true;
+}
+
+void GAFObject::resume()
+{
+    GAFSprite::resume();
+    m_isTickPaused = false;
 }
 
 NS_GAF_END
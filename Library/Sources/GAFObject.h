@@ -5,16 +5,21 @@
 #include "GAFCollections.h"
 #include "GAFTextureAtlas.h"
 #include "GAFFilterData.h"
+#include "GAFLodLevel.h"
+#include "GAFEvaluationCache.h"
+#include "GAFEvaluator.h"
+#include "GAFEventRegistry.h"
 
 NS_GAF_BEGIN
 
 class GAFAsset;
 class GAFTimeline;
+class GAFSubobjectState;
 
 class GAFObject : public GAFSprite
 {
 private:
-    const ax::AffineTransform AffineTransformFlashToCocos(const ax::AffineTransform& aTransform);
+    const ax::AffineTransform AffineTransformFlashToCocos(const ax::AffineTransform& aTransform) const;
 
 public:
 
@@ -25,6 +30,7 @@ private:
     GAFAnimationFinishedPlayDelegate_t      m_animationFinishedPlayDelegate;
     GAFAnimationStartedNextLoopDelegate_t   m_animationStartedNextLoopDelegate;
     GAFFramePlayedDelegate_t                m_framePlayedDelegate;
+    GAFLodSelectorDelegate_t                m_lodSelectorDelegate;
     
     ax::Node*                          m_container;
 
@@ -39,11 +45,95 @@ private:
     double                                  m_timeDelta;
     uint32_t                                m_fps;
     bool                                    m_skipFpsCheck;
+    bool                                    m_isCatchUpEnabled;
+    bool                                    m_isCullingEnabled;
+    bool                                    m_isCulled;
+    unsigned int                            m_culledTick;   // Director frame culling was decided in
+
+    bool                                    m_isInterpolationEnabled;
+    float                                   m_interpolationFactor; // Part of the frame time passed since the shown frame
+    float                                   m_appliedInterpolationFactor;
+    std::vector<const GAFSubobjectState*>   m_nextStates; // Object id -> visible state of the next frame
+
+    LodLevels_t                             m_lodLevels;
+    GAFLodLevel                             m_lod; // Active level, nested timelines get it from the parent
+    uint32_t                                m_lodLevelIndex;
+    uint32_t                                m_lodSkippedFrames;
 
     bool                                    m_animationsSelectorScheduled;
 
     bool                                    m_isInResetState;
 
+    friend class GAFPlaybackManager;
+    uint32_t                                m_playbackIndex; // Slot in GAFPlaybackManager, IDNONE if not ticking
+    uint32_t                                m_playbackClock;
+    bool                                    m_isTickPaused;
+    uint32_t                                m_queuedFramePlayed; // Frame played callback of the object in the deferred queue
+
+    /// Everything a static object's applied state depends on besides the state itself
+    struct StaticInputs
+    {
+        ax::Vec4            parentColorTransforms[2];
+        Filters_t           parentFilters;
+        GAFFilterData*      customFilter = nullptr;
+        ax::Color3B         displayedColor;
+        uint8_t             displayedOpacity = 0;
+        ax::Size            contentSize;
+        ax::Vec2            anchorPoint;
+        unsigned short      cameraMask = 0;
+        bool                flippedX = false;
+        bool                flippedY = false;
+        bool                filtersDisabled = false;
+    };
+
+    StaticInputs                            m_staticInputs;
+    std::vector<bool>                       m_staticObjects; // Object id -> state is the same over the static range
+    uint32_t                                m_staticRangeFirst;
+    uint32_t                                m_staticRangeLast;
+    uint32_t                                m_staticRevision; // Changes whenever static objects must be applied again
+    uint32_t                                m_appliedStaticRevision; // Parent revision this object was applied with
+
+    // Values of the evaluated frame, applied to the nodes on the main thread
+    const GAFAnimationFrame*                m_evaluatedFrame; // Null if nothing is evaluated
+    const GAFEvaluationCache::Entry*        m_evaluatedEntry; // Cache entry the values come from, acquired while used
+    const GAFEvaluatedValue*                m_evaluatedValues; // Visible state index -> value, owned by a cache entry or m_values
+    const GAFEvaluationCache::StateIndices_t* m_evaluatedNestedStates; // Visible state indices of nested timelines
+    GAFEvaluationCache::Values_t            m_values; // Values evaluated by this object
+    GAFEvaluationCache::StateIndices_t      m_nestedStates;
+    GAFEvaluationCache::StateIndices_t      m_batchStates; // Visible state indices evaluated in a batch, flipped ones first
+    size_t                                  m_batchFlippedCount;
+    std::vector<float>                      m_batchScratch; // SoA transforms and color transforms of the batch
+    uint32_t                                m_lastEvaluatedFrame;
+    uint32_t                                m_appliedRevision; // Static revision the evaluated frame was last applied with
+    bool                                    m_isEvaluatedFrameChanged; // Only objects static over the range keep their nodes
+    bool                                    m_isEvaluatedDirty; // Evaluated frame changes some node of the subtree
+    bool                                    m_isNestedPlaying; // Some nested timeline of the frame changes when it is advanced
+    bool                                    m_isNestedChanged; // Playback or inputs of a nested object changed since the evaluation
+    bool                                    m_isRealizeDeferred; // Frames are only advanced, the caller evaluates and applies them
+    GAFEventRegistry*                       m_eventListeners; // Created with the first listener
+    bool                                    m_isFastForwarding; // Frames are passed by a seek, events and delegates of the subtree are not dispatched
+
+    /// Playback position of a nested timeline
+    struct PlaybackState
+    {
+        uint32_t    currentFrame;
+        uint32_t    showingFrame;
+        uint32_t    lastRealizedFrame;
+        uint32_t    sequenceStart;
+        uint32_t    sequenceEnd;
+        bool        isRunning;
+        bool        isLooped;
+        bool        isReversed;
+        bool        isInResetState;
+    };
+    typedef std::vector<PlaybackState> PlaybackStates_t; // Nested timelines depth first in display list order
+
+    std::vector<PlaybackStates_t>           m_checkpoints; // Sequence position / interval -> states after the position is advanced
+    uint32_t                                m_checkpointInterval;
+    uint32_t                                m_checkpointSequenceStart;
+    uint32_t                                m_checkpointSequenceEnd;
+    bool                                    m_checkpointReversed;
+
 private:
     void constructObject();
     GAFObject* _instantiateObject(uint32_t id, GAFCharacterType type, uint32_t reference, bool isMask);
@@ -52,7 +142,65 @@ private:
     /// @note this function is automatically called in start/stop
     void enableTick(bool val);
     void realizeFrame(ax::Node* out, uint32_t frameIndex);
+    /// Updates reset states, advances nested timelines and runs the actions of the frame
+    /// @param isRefresh the frame is already shown, only nested timelines are advanced
+    bool advanceFrame(uint32_t frameIndex, bool isRefresh = false);
+    /// Shows the last realized frame again, only the changes of nested timelines and inputs are applied
+    void refreshFrame();
+    /// Sets the interpolation factor from the time passed since the shown frame
+    void updateInterpolationFactor(double timeDelta);
+    bool isInterpolating() const;
+    /// Re-blends the shown frame when no frame is played by the tick
+    void interpolateFrame();
+    /// Evaluates the last advanced frame of this object and its nested timelines. Changes no nodes, so objects
+    /// that do not share nested timelines may be evaluated on different threads
+    void evaluateFrame();
+    /// Applies the evaluated frame to the nodes, main thread only
+    void applyFrame(ax::Node* out);
+    /// Evaluates the values of the visible states into m_values, composed with the parent by the batch kernels
+    /// @param skipStatic static objects are left without values
+    void evaluateStates(const std::vector<GAFSubobjectState*>& states, const GAFAnimationFrame* nextFrame, float factor,
+        bool skipStatic, float anchorOffsetY, const ax::AffineTransform* flipCenterTransform);
+    GAFFilterData* getStateFilter(const GAFSubobjectState* state, const GAFObject* subObject) const;
+    /// Holds the entry while its values are used, so it is not freed when the cache replaces it
+    void setEvaluatedEntry(const GAFEvaluationCache::Entry* entry);
+    static void getStateColors(const GAFSubobjectState* state, const GAFSubobjectState* next, float factor, float* colorMults, float* colorOffsets);
+    /// State of the next frame the state is blended with, null if it snaps
+    const GAFSubobjectState* getNextState(const GAFSubobjectState* state, const GAFAnimationFrame* nextFrame) const;
+    /// Subobject was applied with the inputs of the evaluated frame and keeps its node
+    bool isStateStatic(const GAFSubobjectState* state, const GAFObject* subObject) const;
+    /// Checks the object against the cameras of its scene once per tick, culled objects are not evaluated
+    /// @returns true if no camera drawing the object sees it
+    bool updateCulling();
+    /// Checks the baked bounds of the last advanced frame against the view of the camera
+    /// @param transform node to world transform
+    bool isOutsideCamera(const ax::Camera* camera, const ax::Mat4& transform) const;
+    void updateLod();
+    void attachSubobject(ax::Node* out, const GAFSubobjectState* state, GAFObject* subObject);
+    void updateResetState(GAFObject* subObject, const GAFSubobjectState* state);
+    void updateStaticObjects(uint32_t first, uint32_t last);
+    bool isStaticInputsChanged() const;
+    bool updateStaticInputs();
+    /// Evaluating the shown frame again changes no node of the subtree
+    bool isEvaluationCurrent() const;
+    /// Makes the parents evaluate their frames again even if they are not advanced
+    void markNestedChanged();
+    bool isInStaticRange(uint32_t frameIndex) const;
     void rearrangeSubobject(ax::Node* out, ax::Node* child, int zIndex);
+    ax::Rect convertTimelineBounds(const ax::Rect& bounds) const;
+    bool getFlipTransform(ax::AffineTransform& flipCenterTransform) const;
+    void captureNestedPlayback(PlaybackStates_t& states) const;
+    void restoreNestedPlayback(const PlaybackStates_t& states, size_t& index);
+    /// Puts nested timelines to the start of their sequences as a fresh object has them
+    void resetNestedPlayback();
+    /// Frame of the current sequence at the position from its start in the playing direction
+    uint32_t getSequenceFrame(uint32_t position) const;
+    bool isFastForwarding() const;
+    void notifyFinishedPlay();
+    /// Calls event listeners of this object, its parents and the asset
+    void dispatchEvent(const GAFTimelineAction& action);
+    /// Advances the frame passed by a seek without running its actions
+    void seekStep(uint32_t position);
 
 protected:
     GAFObject*                              m_timelineParentObject;
@@ -64,7 +212,7 @@ protected:
     GAFObjectType                           m_objectType;
     uint32_t                                m_currentFrame;
     uint32_t                                m_showingFrame; // Frame number that is valid from the beginning of realize frame
-    uint32_t                                m_lastVisibleInFrame; // Last frame that object was visible in
+    uint32_t                                m_lastRealizedFrame;
     Filters_t                               m_parentFilters;
     ax::Vec4                           m_parentColorTransforms[2];
 
@@ -75,6 +223,8 @@ protected:
     void    setTimelineParentObject(GAFObject* obj) { m_timelineParentObject = obj; }
     
     void    processAnimations(float dt);
+    /// @returns true if a played frame is due to be shown
+    bool    playFrames(uint32_t count);
 
     void    instantiateObject(const AnimationObjects_t& objs, const AnimationMasks_t& masks);
 
@@ -99,7 +249,19 @@ public:
     /// @note do not forget to call setFramePlayedDelegate(nullptr) before deleting your subscriber
     void setFramePlayedDelegate(GAFFramePlayedDelegate_t delegate);
 
+    /// Selects the LOD level by index instead of the on-screen scale, e.g. by distance to the camera
+    /// @note do not forget to call setLodSelectorDelegate(nullptr) before deleting your subscriber
+    void setLodSelectorDelegate(GAFLodSelectorDelegate_t delegate);
+
+    /// Listens to timeline events of this object and its nested timelines. Type ids come from GAFEventRegistry::intern
+    /// @returns handle to remove the listener with
+    uint32_t addEventListener(uint32_t eventId, const GAFEventDelegate_t& delegate);
+    uint32_t addEventListener(std::string_view type, const GAFEventDelegate_t& delegate);
+    void removeEventListener(uint32_t handle);
+
     void visit(ax::Renderer *renderer, const ax::Mat4 &transform, uint32_t flags) override;
+    void pause() override;
+    void resume() override;
     void draw(ax::Renderer *renderer, const ax::Mat4 &transform, uint32_t flags) override
     {
         (void)flags;
@@ -137,17 +299,17 @@ public:
     bool        setFrame(uint32_t index);
 
     /// Plays specified frame and then stops excluding enclosed timelines
-    bool        gotoAndStop(const std::string& frameLabel);
+    bool        gotoAndStop(std::string_view frameLabel);
     /// Plays specified frame and then stops excluding enclosed timelines
     bool        gotoAndStop(uint32_t frameNumber);
 
     /// Plays animation from specified frame excluding enclosed timelines
-    bool        gotoAndPlay(const std::string& frameLabel);
+    bool        gotoAndPlay(std::string_view frameLabel);
     /// Plays animation from specified frame excluding enclosed timelines
     bool        gotoAndPlay(uint32_t frameNumber);
 
-    uint32_t    getStartFrame(const std::string& frameLabel);
-    uint32_t    getEndFrame(const std::string& frameLabel);
+    uint32_t    getStartFrame(std::string_view frameLabel);
+    uint32_t    getEndFrame(std::string_view frameLabel);
 
     /// Plays animation sequence with specified name
     /// @param name a sequence name
@@ -155,7 +317,11 @@ public:
     /// @param resume if true - animation will be played immediately, if false - playback will be paused after the first frame is shown
     /// @param hint specific animation playback parameters
 
-    bool        playSequence(const std::string& name, bool looped, bool resume = true);
+    bool        playSequence(std::string_view name, bool looped, bool resume = true);
+
+    /// Plays animation sequence resolved once by GAFTimeline::getSequence
+    /// @param sequence a sequence of this object's timeline
+    bool        playSequence(const GAFAnimationSequence* sequence, bool looped, bool resume = true);
 
     /// Stops playing an animation as a sequence
     void        clearSequence();
@@ -175,6 +341,13 @@ public:
 
     ax::Rect getBoundingBoxForCurrentFrame();
 
+    /// Bounds of the frame content baked at load, in node space. Nested timelines contribute all their frames
+    ax::Rect getBoundsForFrame(uint32_t frame) const;
+    /// Union of the baked frame bounds of the sequence, in node space
+    ax::Rect getBoundsForSequence(std::string_view name) const;
+    /// Frames the visible nested timelines are at, in the order GAFEvaluator expects them
+    void getNestedFrames(GAFNestedFrames_t& frames) const;
+
     const AnimationSequences_t& getSequences() const;
     GAFTimeline* getTimeLine() { return m_timeline; }
     DisplayList_t& getDisplayList() { return m_displayList; }
@@ -194,6 +367,8 @@ public:
         {
             m_customFilter = new FilterSubtype(*filter);
         }
+        ++m_staticRevision;
+        markNestedChanged();
     }
 
     //////////////////////////////////////////////////////////////////////////
@@ -201,16 +376,61 @@ public:
 
     // Searches for an object by given string
     // @param object name e.g. "head" or object path e.g. "knight.body.arm"
-    // @note it can slow down the real-time performance
+    // @note it looks up every part of the path, use resolvePath for per frame queries
     // @returns instance of GAFObject or null. Warning: the instance could be invalidated when the system catches EVENT_COME_TO_FOREGROUND event
-    GAFObject* getObjectByName(const std::string& name);
-    const GAFObject* getObjectByName(const std::string& name) const;
+    GAFObject* getObjectByName(std::string_view name);
+    const GAFObject* getObjectByName(std::string_view name) const;
+
+    // Resolves object path e.g. "knight.body.arm" to the chain of object ids
+    // @returns path handle which is valid for every object of the same timeline, empty if the path is not found
+    ObjectPath_t resolvePath(std::string_view name) const;
+
+    // Searches for an object by path handle returned by resolvePath
+    // @returns instance of GAFObject or null
+    GAFObject* getObjectByPath(const ObjectPath_t& path);
+    const GAFObject* getObjectByPath(const ObjectPath_t& path) const;
 
     uint32_t getFps() const;
 
     void setFps(uint32_t value);
 
     void setFpsLimitations(bool fpsLimitations);
+
+    /// When a tick covers several frames, only the last one is realized. Delegates, actions and events
+    /// of the skipped frames still run in order, but subobject nodes are not updated for them
+    void setCatchUpEnabled(bool enabled);
+    bool isCatchUpEnabled() const;
+
+    /// Skips evaluation and drawing while the baked bounds of the current frame are outside the views of all cameras
+    /// drawing the object. The check is done once per tick with the node and camera transforms of that tick.
+    /// Playback, delegates and events keep going, the frame is applied again when the object is back on screen
+    /// @note works for objects that are not nested into other GAF objects
+    void setCullingEnabled(bool enabled);
+    bool isCullingEnabled() const;
+    bool isCulled() const { return m_isCulled; }
+
+    /// Blends transforms and color transforms between the shown frame and the next one by the time passed,
+    /// so assets exported at a low FPS move smoothly. Objects snap when their display list entry changes
+    /// @note works for objects ticked by GAFPlaybackManager, nested timelines follow their root object
+    void setInterpolationEnabled(bool enabled);
+    bool isInterpolationEnabled() const;
+
+    /// Sets LOD levels from the most detailed to the least detailed, empty disables LOD.
+    /// The level is selected when the object plays frames
+    void setLodLevels(const LodLevels_t& levels);
+    const LodLevels_t& getLodLevels() const { return m_lodLevels; }
+    /// @returns index of the active LOD level, IDNONE if LOD is disabled
+    uint32_t getLodLevelIndex() const { return m_lodLevelIndex; }
+
+    /// Records the playback state of nested timelines every interval frames of the current sequence played from its start.
+    /// Checkpoints are valid until another sequence is played or the direction changes
+    void buildCheckpoints(uint32_t interval);
+    void clearCheckpoints();
+    bool hasCheckpoints() const;
+    /// Shows the frame of the current sequence with nested timelines in the state playback from the sequence start
+    /// brings them to. Replays at most interval - 1 frames from the nearest checkpoint, or the whole way without checkpoints.
+    /// Actions of the passed frames are not run, events and delegates are not dispatched, nodes are updated once
+    bool seekFrame(uint32_t frame);
 };
 
 NS_GAF_END
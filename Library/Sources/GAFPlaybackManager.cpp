@@ -0,0 +1,381 @@
+#include "GAFPrecompiled.h"
+#include "GAFPlaybackManager.h"
+#include "GAFObject.h"
+#include "GAFWorkerPool.h"
+#include "GAFEvaluationCache.h"
+
+NS_GAF_BEGIN
+
+static const char* const kPlaybackSchedulerKey = "GAFPlaybackManager";
+
+GAFPlaybackManager* GAFPlaybackManager::s_instance = nullptr;
+
+GAFPlaybackManager* GAFPlaybackManager::getInstance()
+{
+    if (!s_instance)
+    {
+        s_instance = new GAFPlaybackManager();
+    }
+    return s_instance;
+}
+
+GAFPlaybackManager::GAFPlaybackManager()
+: m_workerPool(nullptr)
+, m_objectsCount(0)
+, m_isTicking(false)
+, m_hasRemovedObjects(false)
+, m_isScheduled(false)
+, m_isDeferredCallbacksEnabled(false)
+{
+}
+
+void GAFPlaybackManager::add(GAFObject* object)
+{
+    if (object->m_playbackIndex != IDNONE)
+    {
+        return;
+    }
+
+    object->m_playbackIndex = static_cast<uint32_t>(m_objects.size());
+    object->m_playbackClock = acquireClock(object->m_fps);
+    m_objects.push_back(object);
+    ++m_objectsCount;
+
+    enableTick(true);
+}
+
+void GAFPlaybackManager::remove(GAFObject* object)
+{
+    const uint32_t index = object->m_playbackIndex;
+    if (index == IDNONE)
+    {
+        return;
+    }
+
+    releaseClock(object->m_playbackClock);
+    object->m_playbackIndex = IDNONE;
+    object->m_playbackClock = IDNONE;
+    --m_objectsCount;
+
+    if (m_isTicking)
+    {
+        // The array is being iterated, it is compacted when the tick is over
+        m_objects[index] = nullptr;
+        m_hasRemovedObjects = true;
+        return;
+    }
+
+    GAFObject* last = m_objects.back();
+    m_objects[index] = last;
+    last->m_playbackIndex = index;
+    m_objects.pop_back();
+
+    if (!m_objectsCount)
+    {
+        enableTick(false);
+    }
+}
+
+void GAFPlaybackManager::setWorkerThreads(unsigned count)
+{
+    AXASSERT(!m_isTicking, "Worker threads cannot be changed during the tick");
+    if (count == getWorkerThreads())
+    {
+        return;
+    }
+
+    AX_SAFE_DELETE(m_workerPool);
+    if (count)
+    {
+        m_workerPool = new GAFWorkerPool(count);
+    }
+}
+
+unsigned GAFPlaybackManager::getWorkerThreads() const
+{
+    return m_workerPool ? m_workerPool->getThreadsCount() : 0;
+}
+
+void GAFPlaybackManager::updateFps(GAFObject* object)
+{
+    if (object->m_playbackIndex == IDNONE)
+    {
+        return;
+    }
+
+    releaseClock(object->m_playbackClock);
+    object->m_playbackClock = acquireClock(object->m_fps);
+}
+
+uint32_t GAFPlaybackManager::acquireClock(uint32_t fps)
+{
+    uint32_t freeClock = IDNONE;
+    for (uint32_t i = 0, count = static_cast<uint32_t>(m_clocks.size()); i < count; ++i)
+    {
+        Clock& clock = m_clocks[i];
+        if (clock.fps == fps)
+        {
+            if (!clock.objectsCount)
+            {
+                clock.timeDelta = 0.0;
+            }
+            ++clock.objectsCount;
+            return i;
+        }
+
+        if (!clock.objectsCount && freeClock == IDNONE)
+        {
+            freeClock = i;
+        }
+    }
+
+    if (freeClock == IDNONE)
+    {
+        freeClock = static_cast<uint32_t>(m_clocks.size());
+        m_clocks.push_back(Clock());
+    }
+
+    Clock& clock = m_clocks[freeClock];
+    clock.fps = fps;
+    clock.objectsCount = 1;
+    clock.timeDelta = 0.0;
+    clock.frames = 0;
+    return freeClock;
+}
+
+void GAFPlaybackManager::releaseClock(uint32_t clockIndex)
+{
+    if (clockIndex < m_clocks.size() && m_clocks[clockIndex].objectsCount)
+    {
+        --m_clocks[clockIndex].objectsCount;
+    }
+}
+
+void GAFPlaybackManager::compact()
+{
+    m_objects.erase(std::remove(m_objects.begin(), m_objects.end(), nullptr), m_objects.end());
+    for (uint32_t i = 0, count = static_cast<uint32_t>(m_objects.size()); i < count; ++i)
+    {
+        m_objects[i]->m_playbackIndex = i;
+    }
+    m_hasRemovedObjects = false;
+}
+
+void GAFPlaybackManager::queueFramePlayed(GAFObject* object, uint32_t frame)
+{
+    // Only the last frame of the tick is reported. It goes after the callbacks queued by the frames before it,
+    // like frame played follows the events of its frame when callbacks are not deferred
+    if (object->m_queuedFramePlayed != IDNONE)
+    {
+        m_callbacks[object->m_queuedFramePlayed].type = QueuedCallback::Type::Coalesced;
+    }
+
+    object->m_queuedFramePlayed = static_cast<uint32_t>(m_callbacks.size());
+    queueCallback(object, QueuedCallback::Type::FramePlayed, frame);
+}
+
+void GAFPlaybackManager::queueSequence(GAFObject* object, const GAFAnimationSequence* sequence)
+{
+    queueCallback(object, QueuedCallback::Type::Sequence, IDNONE, sequence);
+}
+
+void GAFPlaybackManager::queueStartedNextLoop(GAFObject* object)
+{
+    queueCallback(object, QueuedCallback::Type::StartedNextLoop);
+}
+
+void GAFPlaybackManager::queueFinishedPlay(GAFObject* object)
+{
+    queueCallback(object, QueuedCallback::Type::FinishedPlay);
+}
+
+void GAFPlaybackManager::queueEvent(GAFObject* object, const GAFTimelineAction* action)
+{
+    queueCallback(object, QueuedCallback::Type::Event, IDNONE, nullptr, action);
+}
+
+void GAFPlaybackManager::queueCallback(GAFObject* object, QueuedCallback::Type type, uint32_t frame,
+    const GAFAnimationSequence* sequence, const GAFTimelineAction* action)
+{
+    AXASSERT(isDeferringCallbacks(), "Callbacks are queued only while the objects are ticked");
+
+    QueuedCallback callback;
+    callback.object = object;
+    callback.type = type;
+    callback.frame = frame;
+    callback.sequence = sequence;
+    callback.action = action;
+    m_callbacks.push_back(callback);
+
+    // Handlers of earlier callbacks may release the object
+    object->retain();
+}
+
+void GAFPlaybackManager::drainCallbacks()
+{
+    // Callbacks are called outside the tick, so the ones they raise are not queued
+    m_drainedCallbacks.swap(m_callbacks);
+    for (const QueuedCallback& callback : m_drainedCallbacks)
+    {
+        callback.object->m_queuedFramePlayed = IDNONE;
+    }
+
+    for (const QueuedCallback& callback : m_drainedCallbacks)
+    {
+        GAFObject* object = callback.object;
+        switch (callback.type)
+        {
+        case QueuedCallback::Type::FramePlayed:
+            if (object->m_framePlayedDelegate)
+                object->m_framePlayedDelegate(object, callback.frame);
+            break;
+        case QueuedCallback::Type::Sequence:
+            if (object->m_sequenceDelegate)
+                object->m_sequenceDelegate(object, callback.sequence->name);
+            break;
+        case QueuedCallback::Type::StartedNextLoop:
+            if (object->m_animationStartedNextLoopDelegate)
+                object->m_animationStartedNextLoopDelegate(object);
+            break;
+        case QueuedCallback::Type::FinishedPlay:
+            if (object->m_animationFinishedPlayDelegate)
+                object->m_animationFinishedPlayDelegate(object);
+            break;
+        case QueuedCallback::Type::Event:
+            object->dispatchEvent(*callback.action);
+            break;
+        case QueuedCallback::Type::Coalesced:
+            break;
+        }
+    }
+
+    for (const QueuedCallback& callback : m_drainedCallbacks)
+    {
+        callback.object->release();
+    }
+    m_drainedCallbacks.clear();
+}
+
+void GAFPlaybackManager::enableTick(bool val)
+{
+    if (!m_isScheduled && val)
+    {
+        ax::Director::getInstance()->getScheduler()->schedule([this](float dt) { update(dt); }, this, 0, false, kPlaybackSchedulerKey);
+        m_isScheduled = true;
+    }
+    else if (m_isScheduled && !val)
+    {
+        ax::Director::getInstance()->getScheduler()->unschedule(kPlaybackSchedulerKey, this);
+        m_isScheduled = false;
+    }
+}
+
+void GAFPlaybackManager::update(float dt)
+{
+    for (Clock& clock : m_clocks)
+    {
+        clock.frames = 0;
+        if (!clock.objectsCount || !clock.fps)
+        {
+            continue;
+        }
+
+        clock.timeDelta += dt;
+        const double frameTime = 1.0 / clock.fps;
+        while (clock.timeDelta >= frameTime)
+        {
+            clock.timeDelta -= frameTime;
+            ++clock.frames;
+        }
+    }
+
+    m_isTicking = true;
+
+    // Objects started by callbacks of this tick begin to play with the next one
+    for (size_t i = 0, count = m_objects.size(); i < count; ++i)
+    {
+        GAFObject* object = m_objects[i];
+        if (!object || !object->isRunning() || object->m_isTickPaused)
+        {
+            continue;
+        }
+
+        const Clock& clock = m_clocks[object->m_playbackClock];
+        const uint32_t frames = object->m_skipFpsCheck ? 1 : clock.frames;
+        object->updateInterpolationFactor(clock.timeDelta);
+        if (!frames)
+        {
+            if (!object->isInterpolating())
+            {
+                continue;
+            }
+
+            if (!m_workerPool || object->m_timelineParentObject)
+            {
+                object->interpolateFrame();
+            }
+            else if (!object->updateCulling())
+            {
+                object->retain();
+                m_advanced.push_back(object);
+            }
+            continue;
+        }
+
+        // Callbacks may remove the last reference to the object
+        object->retain();
+
+        // Nested timelines are evaluated by their root objects
+        if (!m_workerPool || object->m_timelineParentObject)
+        {
+            object->playFrames(frames);
+            object->release();
+            continue;
+        }
+
+        object->m_isRealizeDeferred = true;
+        const bool isFrameShown = object->playFrames(frames);
+        object->m_isRealizeDeferred = false;
+
+        // Culling needs node transforms, so it is checked here and not by the workers. Paused objects
+        // with nothing changed are not evaluated again
+        if (!isFrameShown || object->updateCulling() || object->isEvaluationCurrent())
+        {
+            object->release();
+            continue;
+        }
+        m_advanced.push_back(object);
+    }
+
+    if (!m_advanced.empty())
+    {
+        // Objects own their nested timelines, so evaluating different objects changes no shared data
+        m_workerPool->parallelFor(m_advanced.size(), [this](size_t i) { m_advanced[i]->evaluateFrame(); });
+
+        for (GAFObject* object : m_advanced)
+        {
+            object->applyFrame(object->m_container);
+            object->release();
+        }
+        m_advanced.clear();
+    }
+
+    m_isTicking = false;
+
+    if (m_hasRemovedObjects)
+    {
+        compact();
+    }
+
+    drainCallbacks();
+
+    // Nothing is evaluated now, cache entries the objects moved away from can be freed
+    GAFEvaluationCache::collect();
+
+    if (!m_objectsCount)
+    {
+        enableTick(false);
+    }
+}
+
+NS_GAF_END
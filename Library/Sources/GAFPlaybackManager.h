@@ -0,0 +1,103 @@
+#pragma once
+
+#include "GAFCollections.h"
+
+NS_GAF_BEGIN
+
+class GAFObject;
+class GAFWorkerPool;
+class GAFTimelineAction;
+
+/// Ticks all playing GAF objects from one scheduler callback.
+/// Objects with the same FPS share a clock, so their frame math is done once per tick
+class GAFPlaybackManager
+{
+public:
+    static GAFPlaybackManager* getInstance();
+
+    void add(GAFObject* object);
+    void remove(GAFObject* object);
+    /// Moves the object to the clock of its current FPS
+    void updateFps(GAFObject* object);
+
+    size_t getObjectsCount() const { return m_objectsCount; }
+
+    /// Evaluates the frames of the tick on worker threads, nodes are still updated on the main thread.
+    /// With parallel evaluation only the last frame played in a tick is shown
+    /// @param count number of threads besides the main one, 0 evaluates everything on the main thread
+    void setWorkerThreads(unsigned count);
+    unsigned getWorkerThreads() const;
+
+    /// Delegates and timeline events raised while objects are ticked are queued and called in order once all objects
+    /// are updated, so handlers may change the scene safely. Frame played delegates of an object are coalesced to the
+    /// last frame of the tick. Sound events and callbacks raised outside the tick are not deferred
+    void setDeferredCallbacksEnabled(bool enabled) { m_isDeferredCallbacksEnabled = enabled; }
+    bool isDeferredCallbacksEnabled() const { return m_isDeferredCallbacksEnabled; }
+    bool isDeferringCallbacks() const { return m_isDeferredCallbacksEnabled && m_isTicking; }
+
+    void queueFramePlayed(GAFObject* object, uint32_t frame);
+    void queueSequence(GAFObject* object, const GAFAnimationSequence* sequence);
+    void queueStartedNextLoop(GAFObject* object);
+    void queueFinishedPlay(GAFObject* object);
+    void queueEvent(GAFObject* object, const GAFTimelineAction* action);
+
+    void update(float dt);
+
+private:
+    GAFPlaybackManager();
+
+    struct Clock
+    {
+        uint32_t    fps;
+        uint32_t    objectsCount;
+        double      timeDelta;
+        uint32_t    frames; // Frames to play in the current tick
+    };
+
+    struct QueuedCallback
+    {
+        enum class Type : uint8_t
+        {
+            FramePlayed = 0,
+            Sequence,
+            StartedNextLoop,
+            FinishedPlay,
+            Event,
+            Coalesced   // Frame played callback replaced by a later one of the object
+        };
+
+        GAFObject*                  object; // retained
+        Type                        type;
+        uint32_t                    frame;
+        const GAFAnimationSequence* sequence;
+        const GAFTimelineAction*    action;
+    };
+
+    typedef std::vector<GAFObject*> Objects_t;
+    typedef std::vector<Clock> Clocks_t;
+    typedef std::vector<QueuedCallback> Callbacks_t;
+
+    uint32_t    acquireClock(uint32_t fps);
+    void        releaseClock(uint32_t clockIndex);
+    void        compact();
+    void        enableTick(bool val);
+    void        queueCallback(GAFObject* object, QueuedCallback::Type type, uint32_t frame = IDNONE,
+                    const GAFAnimationSequence* sequence = nullptr, const GAFTimelineAction* action = nullptr);
+    void        drainCallbacks();
+
+    Objects_t   m_objects;      // Removed slots are nulled while ticking and compacted afterwards
+    Objects_t   m_advanced;     // Objects waiting for evaluation and apply, retained
+    Clocks_t    m_clocks;
+    Callbacks_t m_callbacks;    // Queued during the tick
+    Callbacks_t m_drainedCallbacks;
+    GAFWorkerPool* m_workerPool;
+    size_t      m_objectsCount;
+    bool        m_isTicking;
+    bool        m_hasRemovedObjects;
+    bool        m_isScheduled;
+    bool        m_isDeferredCallbacksEnabled;
+
+    static GAFPlaybackManager* s_instance;
+};
+
+NS_GAF_END
@@ -10,7 +10,8 @@ NS_GAF_BEGIN
 GAFSubobjectState::GAFSubobjectState()
 :
 objectIdRef(IDNONE),
-maskObjectIdRef(IDNONE)
+maskObjectIdRef(IDNONE),
+cocosTransform(ax::AffineTransform::IDENTITY)
 {
     m_refCount = 1;
 }
@@ -36,6 +37,15 @@ void GAFSubobjectState::ctxMakeIdentity()
     _colorMults[GAFCTI_R] = _colorMults[GAFCTI_G] = _colorMults[GAFCTI_B] = 1;
 }
 
+void GAFSubobjectState::convertTransform(float atlasScale)
+{
+    cocosTransform = affineTransform;
+    cocosTransform.b = -cocosTransform.b;
+    cocosTransform.c = -cocosTransform.c;
+    cocosTransform.tx = affineTransform.tx * atlasScale;
+    cocosTransform.ty = -affineTransform.ty * atlasScale;
+}
+
 void GAFSubobjectState::pushFilter(GAFFilterData* filter)
 {
     m_filters.push_back(filter);
@@ -46,6 +56,27 @@ const Filters_t& GAFSubobjectState::getFilters() const
     return m_filters;
 }
 
+bool GAFSubobjectState::isEqual(const GAFSubobjectState& other) const
+{
+    if (this == &other)
+    {
+        return true;
+    }
+
+    return objectIdRef == other.objectIdRef
+        && maskObjectIdRef == other.maskObjectIdRef
+        && zIndex == other.zIndex
+        && affineTransform.a == other.affineTransform.a
+        && affineTransform.b == other.affineTransform.b
+        && affineTransform.c == other.affineTransform.c
+        && affineTransform.d == other.affineTransform.d
+        && affineTransform.tx == other.affineTransform.tx
+        && affineTransform.ty == other.affineTransform.ty
+        && memcmp(_colorMults, other._colorMults, sizeof(_colorMults)) == 0
+        && memcmp(_colorOffsets, other._colorOffsets, sizeof(_colorOffsets)) == 0
+        && m_filters == other.m_filters;
+}
+
 void GAFSubobjectState::addRef()
 {
     m_refCount++;
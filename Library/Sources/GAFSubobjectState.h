@@ -28,6 +28,10 @@ public:
 
     int zIndex;
     ax::AffineTransform affineTransform;
+    ax::AffineTransform cocosTransform; // affineTransform in engine axes scaled by the atlas scale, without the anchor offset
+
+    /// Converts affineTransform to cocosTransform once the atlas scale is chosen
+    void                convertTransform(float atlasScale);
 
     bool initEmpty(unsigned int objectIdRef);
 
@@ -63,6 +67,9 @@ public:
     void                pushFilter(GAFFilterData* filter);
     const Filters_t&    getFilters() const;
 
+    /// Compares everything that is applied to the object. Filters are compared by instance
+    bool                isEqual(const GAFSubobjectState& other) const;
+
 
     void                addRef();
     void                release();
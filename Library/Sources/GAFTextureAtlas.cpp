@@ -36,7 +36,13 @@ void GAFTextureAtlas::pushAtlasInfo(const AtlasInfo& ai)
 
 void GAFTextureAtlas::pushElement(uint32_t idx, GAFTextureAtlasElement* el)
 {
-    m_elements[idx] = el;
+    GAFTextureAtlasElement*& slot = m_elements[idx];
+    if (slot)
+    {
+        unindexElement(idx, slot);
+    }
+    slot = el;
+    indexElement(idx, el);
 }
 
 bool GAFTextureAtlas::swapElement(uint32_t idx, GAFTextureAtlasElement *el)
@@ -44,6 +50,7 @@ bool GAFTextureAtlas::swapElement(uint32_t idx, GAFTextureAtlasElement *el)
     Elements_t::iterator it = m_elements.find(idx);
     if (it != m_elements.end())
     {
+        unindexElement(idx, it->second);
         AX_SAFE_DELETE(it->second);
         m_elements.erase(it);
     }
@@ -52,11 +59,51 @@ bool GAFTextureAtlas::swapElement(uint32_t idx, GAFTextureAtlasElement *el)
     return true;
 }
 
+void GAFTextureAtlas::indexElement(uint32_t idx, GAFTextureAtlasElement* el)
+{
+    if (idx >= m_elementsById.size())
+    {
+        m_elementsById.resize(idx + 1, nullptr);
+    }
+    m_elementsById[idx] = el;
+
+    // Element names must be read before the element is pushed
+    if (el && !el->name.empty())
+    {
+        m_elementsByName.emplace(el->name, el);
+    }
+}
+
+void GAFTextureAtlas::unindexElement(uint32_t idx, GAFTextureAtlasElement* el)
+{
+    if (idx < m_elementsById.size() && m_elementsById[idx] == el)
+    {
+        m_elementsById[idx] = nullptr;
+    }
+
+    ElementsByName_t::iterator it = m_elementsByName.find(el->name);
+    if (it != m_elementsByName.end() && it->second == el)
+    {
+        m_elementsByName.erase(it);
+    }
+}
+
 const GAFTextureAtlas::Elements_t& GAFTextureAtlas::getElements() const
 {
     return m_elements;
 }
 
+GAFTextureAtlasElement* GAFTextureAtlas::getElement(uint32_t idx) const
+{
+    return idx < m_elementsById.size() ? m_elementsById[idx] : nullptr;
+}
+
+GAFTextureAtlasElement* GAFTextureAtlas::getElementByName(std::string_view name) const
+{
+    ElementsByName_t::const_iterator it = m_elementsByName.find(name);
+    return it != m_elementsByName.end() ? it->second : nullptr;
+}
+
 const GAFTextureAtlas::AtlasInfos_t& GAFTextureAtlas::getAtlasInfos() const
 {
 	return m_atlasInfos;
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <unordered_map>
+#include <string_view>
+
 NS_GAF_BEGIN
 
 class GAFTextureAtlasElement;
@@ -26,6 +29,8 @@ public:
 
     typedef std::vector<AtlasInfo> AtlasInfos_t;
     typedef std::map<uint32_t, GAFTextureAtlasElement*> Elements_t;
+    typedef std::vector<GAFTextureAtlasElement*> ElementsById_t;                           // Element atlas id -> element
+    typedef std::unordered_map<std::string_view, GAFTextureAtlasElement*> ElementsByName_t; // Views to element names
 
     GAFTextureAtlas();
 private:
@@ -33,6 +38,11 @@ private:
     float           m_scale;
     AtlasInfos_t    m_atlasInfos;
     Elements_t      m_elements;
+    ElementsById_t  m_elementsById;
+    ElementsByName_t m_elementsByName;
+
+    void    indexElement(uint32_t idx, GAFTextureAtlasElement* el);
+    void    unindexElement(uint32_t idx, GAFTextureAtlasElement* el);
 public:
     ~GAFTextureAtlas();
 
@@ -44,6 +54,10 @@ public:
     float   getScale() const;
 
     const Elements_t& getElements() const;
+    /// @returns element by its atlas id or null
+    GAFTextureAtlasElement* getElement(uint32_t idx) const;
+    /// @returns first element with given name or null
+    GAFTextureAtlasElement* getElementByName(std::string_view name) const;
     const AtlasInfos_t& getAtlasInfos() const;
 };
 
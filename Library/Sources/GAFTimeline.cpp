@@ -2,7 +2,12 @@
 #include "GAFTimeline.h"
 #include "GAFTextureAtlas.h"
 #include "GAFAnimationFrame.h"
+#include "GAFSubobjectState.h"
+#include "GAFTextureAtlasElement.h"
 #include "GAFTextData.h"
+#include "GAFEvaluationCache.h"
+
+#include <unordered_set>
 
 NS_GAF_BEGIN
 
@@ -15,6 +20,10 @@ m_id(id)
 , m_sceneFps(0)
 , m_sceneWidth(0)
 , m_sceneHeight(0)
+, m_boundsState(BoundsState::None)
+, m_evaluationCache(nullptr)
+, m_flattened(nullptr)
+, m_source(nullptr)
 {
 
 }
@@ -25,6 +34,38 @@ GAFTimeline::~GAFTimeline()
     GAF_RELEASE_ARRAY(AnimationFrames_t, m_animationFrames);
     GAF_RELEASE_MAP(TextsData_t, m_textsData);
     GAF_RELEASE_MAP(CustomData_t, m_userData);
+    if (m_evaluationCache)
+    {
+        // Objects playing the timeline are gone, it is freed right away
+        m_evaluationCache->destroy();
+        GAFEvaluationCache::collect();
+    }
+    if (m_flattened != this)
+    {
+        AX_SAFE_RELEASE(m_flattened);
+    }
+}
+
+void GAFTimeline::setEvaluationCacheEnabled(bool enabled)
+{
+    if (!enabled)
+    {
+        // Objects may still hold entries of the cache, it is freed once they move on
+        if (m_evaluationCache)
+        {
+            m_evaluationCache->destroy();
+            m_evaluationCache = nullptr;
+        }
+    }
+    else if (!m_evaluationCache)
+    {
+        m_evaluationCache = new GAFEvaluationCache(m_framesCount);
+    }
+
+    if (m_flattened && m_flattened != this)
+    {
+        m_flattened->setEvaluationCacheEnabled(enabled);
+    }
 }
 
 void GAFTimeline::pushTextureAtlas(GAFTextureAtlas* atlas)
@@ -54,12 +95,14 @@ void GAFTimeline::pushAnimationSequence(const std::string& nameId, int start, in
     seq.startFrameNo = start;
     seq.endFrameNo = end;
 
-    m_animationSequences[nameId] = seq;
+    AnimationSequences_t::iterator it = m_animationSequences.insert_or_assign(nameId, seq).first;
+    m_sequencesIndex[it->first] = &it->second;
 }
 
 void GAFTimeline::pushNamedPart(unsigned int objectIdRef, const std::string& name)
 {
-    m_namedParts[name] = objectIdRef;
+    NamedParts_t::iterator it = m_namedParts.insert_or_assign(name, objectIdRef).first;
+    m_namedPartsIndex[it->first] = objectIdRef;
 }
 
 void GAFTimeline::pushTextData(uint32_t objectIdRef, GAFTextData* textField)
@@ -114,7 +157,7 @@ const NamedParts_t& GAFTimeline::getNamedParts() const
 
 TextsData_t const& GAFTimeline::getTextsData() const
 {
-    return m_textsData;
+    return m_source ? m_source->getTextsData() : m_textsData;
 }
 
 const TextureAtlases_t& GAFTimeline::getTextureAtlases() const
@@ -122,31 +165,35 @@ const TextureAtlases_t& GAFTimeline::getTextureAtlases() const
     return m_textureAtlases;
 }
 
-const GAFAnimationSequence* GAFTimeline::getSequence(const std::string& name) const
+const GAFAnimationSequence* GAFTimeline::getSequence(std::string_view name) const
 {
-    AnimationSequences_t::const_iterator it = m_animationSequences.find(name);
+    SequencesIndex_t::const_iterator it = m_sequencesIndex.find(name);
 
-    if (it != m_animationSequences.end())
+    if (it != m_sequencesIndex.end())
     {
-        return &it->second;
+        return it->second;
     }
 
     return nullptr;
 }
 
-const GAFAnimationSequence * GAFTimeline::getSequenceByLastFrame(size_t frame) const
+uint32_t GAFTimeline::getNamedPartId(std::string_view name) const
 {
-    if (m_animationSequences.empty())
+    NamedPartsIndex_t::const_iterator it = m_namedPartsIndex.find(name);
+
+    if (it != m_namedPartsIndex.end())
     {
-        return nullptr;
+        return it->second;
     }
 
-    for (AnimationSequences_t::const_iterator i = m_animationSequences.begin(), e = m_animationSequences.end(); i != e; ++i)
+    return IDNONE;
+}
+
+const GAFAnimationSequence * GAFTimeline::getSequenceByLastFrame(size_t frame) const
+{
+    if (frame < m_sequencesByLastFrame.size())
     {
-        if (i->second.endFrameNo == frame + 1)
-        {
-            return &i->second;
-        }
+        return m_sequencesByLastFrame[frame];
     }
 
     return nullptr;
@@ -154,17 +201,9 @@ const GAFAnimationSequence * GAFTimeline::getSequenceByLastFrame(size_t frame) c
 
 const GAFAnimationSequence * GAFTimeline::getSequenceByFirstFrame(size_t frame) const
 {
-    if (m_animationSequences.empty())
-    {
-        return nullptr;
-    }
-
-    for (AnimationSequences_t::const_iterator i = m_animationSequences.begin(), e = m_animationSequences.end(); i != e; ++i)
+    if (frame < m_sequencesByFirstFrame.size())
     {
-        if (i->second.startFrameNo == frame)
-        {
-            return &i->second;
-        }
+        return m_sequencesByFirstFrame[frame];
     }
 
     return nullptr;
@@ -195,7 +234,7 @@ const ax::Point GAFTimeline::getPivot() const
     return m_pivot;
 }
 
-const std::string GAFTimeline::getLinkageName() const
+const std::string& GAFTimeline::getLinkageName() const
 {
     return m_linkageName;
 }
@@ -211,9 +250,501 @@ void GAFTimeline::loadImages(float desiredAtlasScale)
     {
         m_currentTextureAtlas = nullptr;
         m_usedAtlasContentScaleFactor = desiredAtlasScale;
+    }
+    else
+    {
+        _chooseTextureAtlas(desiredAtlasScale);
+    }
+    _convertTransforms();
+}
+
+void GAFTimeline::_convertTransforms()
+{
+    // States shared by several frames are converted several times, the result is the same
+    for (GAFAnimationFrame* frame : m_animationFrames)
+    {
+        for (GAFSubobjectState* state : frame->getObjectStates())
+        {
+            state->convertTransform(m_usedAtlasContentScaleFactor);
+        }
+    }
+}
+
+void GAFTimeline::prepare()
+{
+    const size_t count = m_animationFrames.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        m_animationFrames[i]->prepare(this, m_animationFrames[(i + count - 1) % count]);
+    }
+
+    _analyzeStaticObjects();
+    _indexEvents();
+
+    m_sequencesByFirstFrame.assign(m_framesCount, nullptr);
+    m_sequencesByLastFrame.assign(m_framesCount, nullptr);
+
+    if (m_animationSequences.empty())
+    {
+        m_sequencesByFirstFrame.clear();
+        m_sequencesByLastFrame.clear();
+        return;
+    }
+
+    for (AnimationSequences_t::const_iterator i = m_animationSequences.begin(), e = m_animationSequences.end(); i != e; ++i)
+    {
+        const GAFAnimationSequence* seq = &i->second;
+
+        // The first sequence found wins, as it was with the lookup by iteration
+        if (seq->startFrameNo < m_framesCount && !m_sequencesByFirstFrame[seq->startFrameNo])
+        {
+            m_sequencesByFirstFrame[seq->startFrameNo] = seq;
+        }
+
+        if (seq->endFrameNo > 0 && seq->endFrameNo <= m_framesCount && !m_sequencesByLastFrame[seq->endFrameNo - 1])
+        {
+            m_sequencesByLastFrame[seq->endFrameNo - 1] = seq;
+        }
+    }
+}
+
+void GAFTimeline::_analyzeStaticObjects()
+{
+    m_objectChangeFrames.clear();
+    m_staticStats = GAFStaticStats();
+    m_staticStats.timelineCount = 1;
+
+    std::vector<const GAFSubobjectState*> previousStates;
+    bool hasActions = false;
+
+    const uint32_t count = static_cast<uint32_t>(m_animationFrames.size());
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const GAFAnimationFrame* frame = m_animationFrames[i];
+        hasActions = hasActions || !frame->getTimelineActions().empty();
+
+        std::vector<const GAFSubobjectState*> currentStates(previousStates.size(), nullptr);
+        for (const GAFSubobjectState* state : frame->getObjectStates())
+        {
+            const uint32_t id = state->objectIdRef;
+            if (id >= currentStates.size())
+            {
+                currentStates.resize(id + 1, nullptr);
+                previousStates.resize(id + 1, nullptr);
+                m_objectChangeFrames.resize(id + 1);
+            }
+            currentStates[id] = state;
+
+            const GAFSubobjectState* previous = previousStates[id];
+            if (!previous || !previous->isEqual(*state))
+            {
+                m_objectChangeFrames[id].push_back(i);
+            }
+        }
+
+        // Object disappearing from the frame is a change as well
+        for (size_t id = 0; id < previousStates.size(); ++id)
+        {
+            if (previousStates[id] && !currentStates[id])
+            {
+                m_objectChangeFrames[id].push_back(i);
+            }
+        }
+
+        previousStates.swap(currentStates);
+    }
+
+    for (uint32_t id = 0; id < m_objectChangeFrames.size(); ++id)
+    {
+        if (m_objectChangeFrames[id].empty())
+        {
+            continue;
+        }
+
+        ++m_staticStats.objectCount;
+        if (isObjectStatic(id))
+        {
+            ++m_staticStats.staticObjectCount;
+        }
+    }
+
+    if (!hasActions && m_staticStats.staticObjectCount == m_staticStats.objectCount)
+    {
+        m_staticStats.staticTimelineCount = 1;
+    }
+}
+
+bool GAFTimeline::isObjectStatic(uint32_t objectId) const
+{
+    return !m_animationFrames.empty() && isObjectStatic(objectId, 0, static_cast<uint32_t>(m_animationFrames.size()) - 1);
+}
+
+bool GAFTimeline::isObjectStatic(uint32_t objectId, uint32_t first, uint32_t last) const
+{
+    if (objectId >= m_objectChangeFrames.size())
+    {
+        return false;
+    }
+
+    const ChangeFrames_t& changes = m_objectChangeFrames[objectId];
+
+    // Object must be present at the first frame and not change until the last one
+    if (changes.empty() || changes.front() > first)
+    {
+        return false;
+    }
+    ChangeFrames_t::const_iterator next = std::upper_bound(changes.begin(), changes.end(), first);
+    return next == changes.end() || *next > last;
+}
+
+bool GAFTimeline::isStatic() const
+{
+    return m_staticStats.staticTimelineCount != 0;
+}
+
+const GAFStaticStats& GAFTimeline::getStaticStats() const
+{
+    return m_staticStats;
+}
+
+bool GAFTimeline::_getObjectBounds(uint32_t objectId, const Timelines_t& timelines, ax::Rect& bounds)
+{
+    AnimationObjects_t::const_iterator it = m_animationObjects.find(objectId);
+    if (it == m_animationObjects.end())
+    {
+        return false; // Masks are not drawn
+    }
+
+    const uint32_t reference = std::get<0>(it->second);
+    switch (std::get<1>(it->second))
+    {
+    case GAFCharacterType::Texture:
+    {
+        const GAFTextureAtlasElement* element = m_currentTextureAtlas ? m_currentTextureAtlas->getElement(reference) : nullptr;
+        if (!element)
+        {
+            return false;
+        }
+
+        float width = element->bounds.size.width;
+        float height = element->bounds.size.height;
+        if (element->rotation != GAFRotation::NONE)
+        {
+            std::swap(width, height);
+        }
+
+        const float scale = 1.f / element->getScale();
+        bounds = ax::Rect(-element->pivotPoint.x * scale, -element->pivotPoint.y * scale, width * scale, height * scale);
+        return true;
+    }
+    case GAFCharacterType::TextField:
+    {
+        TextsData_t::const_iterator textData = m_textsData.find(reference);
+        if (textData == m_textsData.end())
+        {
+            return false;
+        }
+
+        const GAFTextData* data = textData->second;
+        bounds = ax::Rect(-data->m_pivot.x, -data->m_pivot.y, data->m_width, data->m_height);
+        return true;
+    }
+    case GAFCharacterType::Timeline:
+    {
+        Timelines_t::const_iterator timeline = timelines.find(reference);
+        if (timeline == timelines.end())
+        {
+            return false;
+        }
+
+        timeline->second->bakeBounds(timelines);
+        if (timeline->second->m_boundsState != BoundsState::Baked)
+        {
+            return false; // Timeline encloses itself
+        }
+        bounds = timeline->second->getBounds();
+        return true;
+    }
+    }
+    return false;
+}
+
+void GAFTimeline::bakeBounds(const Timelines_t& timelines)
+{
+    if (m_boundsState != BoundsState::None)
+    {
         return;
     }
-    _chooseTextureAtlas(desiredAtlasScale);
+    m_boundsState = BoundsState::Baking;
+
+    // Object bounds do not depend on the frame
+    const size_t objectCount = m_objectChangeFrames.size();
+    std::vector<ax::Rect> objectBounds(objectCount);
+    std::vector<bool> hasObjectBounds(objectCount, false);
+    for (uint32_t id = 0; id < objectCount; ++id)
+    {
+        hasObjectBounds[id] = _getObjectBounds(id, timelines, objectBounds[id]);
+    }
+
+    const float csf = m_usedAtlasContentScaleFactor;
+    bool hasBounds = false;
+    m_bounds = ax::Rect::ZERO;
+    m_frameBounds.assign(m_animationFrames.size(), ax::Rect::ZERO);
+
+    for (size_t i = 0; i < m_animationFrames.size(); ++i)
+    {
+        bool hasFrameBounds = false;
+        ax::Rect& frameBounds = m_frameBounds[i];
+
+        for (const GAFSubobjectState* state : m_animationFrames[i]->getVisibleObjectStates())
+        {
+            const uint32_t id = state->objectIdRef;
+            if (id >= objectCount || !hasObjectBounds[id])
+            {
+                continue;
+            }
+
+            ax::AffineTransform stateTransform = state->affineTransform;
+            stateTransform.tx *= csf;
+            stateTransform.ty *= csf;
+            ax::Rect stateBounds = ax::RectApplyAffineTransform(objectBounds[id], stateTransform);
+
+            if (hasFrameBounds)
+            {
+                frameBounds.merge(stateBounds);
+            }
+            else
+            {
+                frameBounds = stateBounds;
+                hasFrameBounds = true;
+            }
+        }
+
+        if (!hasFrameBounds)
+        {
+            continue;
+        }
+
+        if (hasBounds)
+        {
+            m_bounds.merge(frameBounds);
+        }
+        else
+        {
+            m_bounds = frameBounds;
+            hasBounds = true;
+        }
+    }
+
+    _bakeHitboxes(timelines, objectBounds, hasObjectBounds);
+
+    for (AnimationSequences_t::iterator it = m_animationSequences.begin(), e = m_animationSequences.end(); it != e; ++it)
+    {
+        GAFAnimationSequence& seq = it->second;
+        seq.bounds = ax::Rect::ZERO;
+
+        bool hasSequenceBounds = false;
+        const size_t last = std::min<size_t>(seq.endFrameNo, m_frameBounds.size());
+        for (size_t frame = seq.startFrameNo; frame < last; ++frame)
+        {
+            const ax::Rect& frameBounds = m_frameBounds[frame];
+            if (frameBounds.equals(ax::Rect::ZERO))
+            {
+                continue; // Nothing is visible
+            }
+
+            if (hasSequenceBounds)
+            {
+                seq.bounds.merge(frameBounds);
+            }
+            else
+            {
+                seq.bounds = frameBounds;
+                hasSequenceBounds = true;
+            }
+        }
+    }
+
+    m_boundsState = BoundsState::Baked;
+}
+
+const ax::Rect& GAFTimeline::getFrameBounds(uint32_t frame) const
+{
+    return frame < m_frameBounds.size() ? m_frameBounds[frame] : ax::Rect::ZERO;
+}
+
+const ax::Rect& GAFTimeline::getBounds() const
+{
+    return m_bounds;
+}
+
+void GAFTimeline::_bakeHitboxes(const Timelines_t& timelines, const std::vector<ax::Rect>& objectBounds, const std::vector<bool>& hasObjectBounds)
+{
+    m_hitboxParts.clear();
+    for (NamedParts_t::const_iterator it = m_namedParts.begin(), e = m_namedParts.end(); it != e; ++it)
+    {
+        const uint32_t id = it->second;
+        if (id < hasObjectBounds.size() && hasObjectBounds[id])
+        {
+            m_hitboxParts.emplace(id, static_cast<uint32_t>(m_hitboxParts.size()));
+        }
+    }
+
+    const size_t framesCount = m_animationFrames.size();
+    m_hitboxes.assign(m_hitboxParts.size() * framesCount, GAFHitbox());
+
+    // Nested timeline parts use the bounds of the nested frame they show, when it does not depend on the playback
+    std::vector<const GAFTimeline*> nestedParts(m_hitboxParts.size(), nullptr);
+    std::vector<std::vector<uint32_t>> nestedFrames(m_hitboxParts.size());
+    if (_isPlayedInLoop())
+    {
+        for (const std::unordered_map<uint32_t, uint32_t>::value_type& part : m_hitboxParts)
+        {
+            const AnimationObjectEx_t& object = m_animationObjects[part.first];
+            if (std::get<1>(object) != GAFCharacterType::Timeline)
+            {
+                continue;
+            }
+
+            Timelines_t::const_iterator tl = timelines.find(std::get<0>(object));
+            if (tl != timelines.end() && tl->second->_isPlayedInLoop()
+                && _getNestedFrames(part.first, tl->second->getFramesCount(), nestedFrames[part.second]))
+            {
+                nestedParts[part.second] = tl->second;
+            }
+        }
+    }
+
+    const float csf = m_usedAtlasContentScaleFactor;
+    for (size_t i = 0; i < framesCount; ++i)
+    {
+        for (const GAFSubobjectState* state : m_animationFrames[i]->getVisibleObjectStates())
+        {
+            std::unordered_map<uint32_t, uint32_t>::const_iterator part = m_hitboxParts.find(state->objectIdRef);
+            if (part == m_hitboxParts.end())
+            {
+                continue;
+            }
+
+            ax::AffineTransform stateTransform = state->affineTransform;
+            stateTransform.tx *= csf;
+            stateTransform.ty *= csf;
+
+            const ax::Rect* partBounds = &objectBounds[state->objectIdRef];
+            if (const GAFTimeline* nested = nestedParts[part->second])
+            {
+                const uint32_t nestedFrame = nestedFrames[part->second][i];
+                if (nestedFrame == IDNONE || nested->getFrameBounds(nestedFrame).equals(ax::Rect::ZERO))
+                {
+                    continue; // Nothing of the nested timeline is drawn
+                }
+                partBounds = &nested->getFrameBounds(nestedFrame);
+            }
+
+            const ax::Rect& bounds = *partBounds;
+            GAFHitbox& hitbox = m_hitboxes[part->second * framesCount + i];
+            hitbox.points[0] = ax::PointApplyAffineTransform(ax::Vec2(bounds.getMinX(), bounds.getMinY()), stateTransform);
+            hitbox.points[1] = ax::PointApplyAffineTransform(ax::Vec2(bounds.getMaxX(), bounds.getMinY()), stateTransform);
+            hitbox.points[2] = ax::PointApplyAffineTransform(ax::Vec2(bounds.getMaxX(), bounds.getMaxY()), stateTransform);
+            hitbox.points[3] = ax::PointApplyAffineTransform(ax::Vec2(bounds.getMinX(), bounds.getMaxY()), stateTransform);
+            hitbox.isVisible = true;
+        }
+    }
+}
+
+const GAFHitbox* GAFTimeline::getHitbox(uint32_t objectId, uint32_t frame) const
+{
+    std::unordered_map<uint32_t, uint32_t>::const_iterator part = m_hitboxParts.find(objectId);
+    if (part == m_hitboxParts.end() || frame >= m_animationFrames.size())
+    {
+        return nullptr;
+    }
+
+    const GAFHitbox* hitbox = &m_hitboxes[part->second * m_animationFrames.size() + frame];
+    return hitbox->isVisible ? hitbox : nullptr;
+}
+
+const GAFHitbox* GAFTimeline::getHitbox(std::string_view partName, uint32_t frame) const
+{
+    return getHitbox(getNamedPartId(partName), frame);
+}
+
+static bool compareEventFrames(const GAFTimelineEvent& event, uint32_t frame)
+{
+    return event.frame < frame;
+}
+
+static bool compareFrameEvents(uint32_t frame, const GAFTimelineEvent& event)
+{
+    return frame < event.frame;
+}
+
+void GAFTimeline::_indexEvents()
+{
+    m_events.clear();
+
+    for (AnimationSequences_t::const_iterator it = m_animationSequences.begin(), e = m_animationSequences.end(); it != e; ++it)
+    {
+        const GAFAnimationSequence* seq = &it->second;
+        if (seq->endFrameNo <= seq->startFrameNo)
+        {
+            continue;
+        }
+        m_events.push_back({ seq->startFrameNo, GAFTimelineEvent::Type::SequenceStart, nullptr, seq });
+        m_events.push_back({ seq->endFrameNo - 1, GAFTimelineEvent::Type::SequenceEnd, nullptr, seq });
+    }
+
+    for (uint32_t i = 0, count = static_cast<uint32_t>(m_animationFrames.size()); i < count; ++i)
+    {
+        for (const GAFTimelineAction& action : m_animationFrames[i]->getTimelineActions())
+        {
+            if (action.getType() == GAFActionType::DispatchEvent)
+            {
+                GAFTimelineEvent::Type type = action.isSoundEvent() ? GAFTimelineEvent::Type::Sound : GAFTimelineEvent::Type::Event;
+                m_events.push_back({ i, type, &action, nullptr });
+            }
+        }
+    }
+
+    // Within a frame sequence starts go first and sequence ends last. Events and sounds share one class,
+    // so the stable sort keeps them in the authored order. Sequences sharing a frame and a type are ordered by name
+    auto typeOrder = [](GAFTimelineEvent::Type type)
+    {
+        return type == GAFTimelineEvent::Type::SequenceStart ? 0 : type == GAFTimelineEvent::Type::SequenceEnd ? 2 : 1;
+    };
+    std::stable_sort(m_events.begin(), m_events.end(), [&typeOrder](const GAFTimelineEvent& a, const GAFTimelineEvent& b)
+    {
+        if (a.frame != b.frame)
+            return a.frame < b.frame;
+        const int orderA = typeOrder(a.type);
+        const int orderB = typeOrder(b.type);
+        if (orderA != orderB)
+            return orderA < orderB;
+        return a.sequence && b.sequence && a.sequence->name < b.sequence->name;
+    });
+}
+
+const TimelineEvents_t& GAFTimeline::getEvents() const
+{
+    return m_events;
+}
+
+TimelineEventsRange_t GAFTimeline::getEvents(uint32_t first, uint32_t last) const
+{
+    if (first > last)
+    {
+        return TimelineEventsRange_t(m_events.end(), m_events.end());
+    }
+
+    TimelineEvents_t::const_iterator begin = std::lower_bound(m_events.begin(), m_events.end(), first, compareEventFrames);
+    TimelineEvents_t::const_iterator end = std::upper_bound(begin, m_events.end(), last, compareFrameEvents);
+    return TimelineEventsRange_t(begin, end);
+}
+
+const GAFTimelineEvent* GAFTimeline::getNextEvent(uint32_t frame) const
+{
+    TimelineEvents_t::const_iterator it = std::upper_bound(m_events.begin(), m_events.end(), frame, compareFrameEvents);
+    return it != m_events.end() ? &*it : nullptr;
 }
 
 void GAFTimeline::_chooseTextureAtlas(float desiredAtlasScale)
@@ -237,6 +768,410 @@ void GAFTimeline::_chooseTextureAtlas(float desiredAtlasScale)
     m_usedAtlasContentScaleFactor = atlasScale;
 }
 
+GAFTimeline* GAFTimeline::getFlattened(const Timelines_t& timelines)
+{
+    if (!m_flattened)
+    {
+        m_flattened = this; // Guards against cyclic references
+        GAFTimeline* flattened = _flatten(timelines);
+        if (flattened)
+        {
+            m_flattened = flattened;
+        }
+    }
+    return m_flattened;
+}
+
+GAFTimeline* GAFTimeline::getObjectSource(uint32_t objectId)
+{
+    ObjectSources_t::const_iterator it = m_objectSources.find(objectId);
+    return it != m_objectSources.end() ? it->second : (m_source ? m_source : this);
+}
+
+const GAFTimeline* GAFTimeline::getObjectSource(uint32_t objectId) const
+{
+    ObjectSources_t::const_iterator it = m_objectSources.find(objectId);
+    return it != m_objectSources.end() ? it->second : (m_source ? m_source : this);
+}
+
+bool GAFTimeline::_hasFilters() const
+{
+    for (const GAFAnimationFrame* frame : m_animationFrames)
+    {
+        for (const GAFSubobjectState* state : frame->getObjectStates())
+        {
+            if (!state->getFilters().empty())
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool GAFTimeline::_canBeFlattened() const
+{
+    if (!m_animationSequences.empty() || !m_animationMasks.empty() || !m_namedParts.empty() || m_animationFrames.empty())
+    {
+        return false;
+    }
+
+    for (const AnimationObjects_t::value_type& it : m_animationObjects)
+    {
+        if (std::get<1>(it.second) == GAFCharacterType::Timeline)
+        {
+            return false;
+        }
+    }
+
+    for (const GAFAnimationFrame* frame : m_animationFrames)
+    {
+        if (!frame->getTimelineActions().empty())
+        {
+            return false;
+        }
+    }
+
+    return !_hasFilters();
+}
+
+bool GAFTimeline::_isPlayedInLoop() const
+{
+    // Sequences are played by the user, stops and gotos change the flow, frames of nested objects
+    // cannot be known in advance then
+    if (!m_animationSequences.empty())
+    {
+        return false;
+    }
+
+    for (const GAFAnimationFrame* frame : m_animationFrames)
+    {
+        for (const GAFTimelineAction& action : frame->getTimelineActions())
+        {
+            const GAFActionType type = action.getType();
+            if (type == GAFActionType::Stop || type == GAFActionType::GotoAndStop || type == GAFActionType::GotoAndPlay)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static const GAFSubobjectState* findObjectState(const GAFAnimationFrame* frame, uint32_t objectId)
+{
+    for (const GAFSubobjectState* state : frame->getObjectStates())
+    {
+        if (state->objectIdRef == objectId)
+        {
+            return state;
+        }
+    }
+    return nullptr;
+}
+
+bool GAFTimeline::_getNestedFrames(uint32_t objectId, uint32_t nestedFramesCount, std::vector<uint32_t>& nestedFrames) const
+{
+    // Repeats what the nested object does when this timeline plays in a loop, which is the only way it plays,
+    // see _isPlayedInLoop. The frames have to be the same
+    // in the second loop, otherwise they depend on the playback history
+    nestedFrames.assign(m_animationFrames.size(), IDNONE);
+
+    // Nested objects are not looped, they stop on their last frame and stay there until they are reset
+    uint32_t currentFrame = GAFFirstFrameIndex;
+    bool isRunning = true;
+    bool isInResetState = false;
+    for (int loop = 0; loop < 2; ++loop)
+    {
+        for (size_t i = 0, count = m_animationFrames.size(); i < count; ++i)
+        {
+            const GAFSubobjectState* state = findObjectState(m_animationFrames[i], objectId);
+            if (!state)
+            {
+                return false;
+            }
+
+            const bool isReset = state->colorMults()[GAFCTI_A] < 0.f;
+            if (!isReset && isInResetState)
+            {
+                currentFrame = GAFFirstFrameIndex;
+            }
+            isInResetState = isReset;
+
+            uint32_t shownFrame = IDNONE;
+            if (state->isVisible() && !isReset)
+            {
+                shownFrame = currentFrame;
+                if (isRunning && currentFrame + 1 < nestedFramesCount)
+                {
+                    ++currentFrame;
+                }
+                else
+                {
+                    isRunning = false;
+                }
+            }
+
+            if (loop == 0)
+            {
+                nestedFrames[i] = shownFrame;
+            }
+            else if (nestedFrames[i] != shownFrame)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+GAFTimeline* GAFTimeline::_flatten(const Timelines_t& timelines)
+{
+    // Flattened states are copies, and states own their filters
+    if (_hasFilters() || !_isPlayedInLoop())
+    {
+        return nullptr;
+    }
+
+    struct Placement
+    {
+        uint32_t                objectId;
+        GAFTimeline*            nested;
+        std::vector<uint32_t>   nestedFrames;   // Frame -> shown nested frame, IDNONE if hidden
+        std::vector<uint32_t>   nestedObjects;  // Nested object ids in the order of flat ids
+        uint32_t                firstFlatId;
+    };
+    std::vector<Placement> placements;
+
+    std::vector<uint32_t> objectIds;
+    uint32_t maxObjectId = 0;
+    for (const AnimationObjects_t::value_type& it : m_animationObjects)
+    {
+        objectIds.push_back(it.first);
+        maxObjectId = std::max(maxObjectId, it.first);
+    }
+    for (const AnimationMasks_t::value_type& it : m_animationMasks)
+    {
+        maxObjectId = std::max(maxObjectId, it.first);
+    }
+    std::sort(objectIds.begin(), objectIds.end());
+
+    // Named parts stay objects, they may be accessed by name
+    std::unordered_set<uint32_t> namedObjects;
+    for (const NamedParts_t::value_type& it : m_namedParts)
+    {
+        namedObjects.insert(it.second);
+    }
+
+    int minNestedZ = INT_MAX;
+    int maxNestedZ = INT_MIN;
+    for (uint32_t objectId : objectIds)
+    {
+        const AnimationObjectEx_t& object = m_animationObjects[objectId];
+        if (std::get<1>(object) != GAFCharacterType::Timeline || m_animationMasks.count(objectId) || namedObjects.count(objectId))
+        {
+            continue;
+        }
+
+        Timelines_t::const_iterator tl = timelines.find(std::get<0>(object));
+        if (tl == timelines.end())
+        {
+            continue;
+        }
+
+        GAFTimeline* nested = tl->second->getFlattened(timelines);
+        Placement placement;
+        if (!nested->_canBeFlattened() || !_getNestedFrames(objectId, nested->getFramesCount(), placement.nestedFrames))
+        {
+            continue;
+        }
+
+        placement.objectId = objectId;
+        placement.nested = nested;
+        for (const AnimationObjects_t::value_type& it : nested->m_animationObjects)
+        {
+            placement.nestedObjects.push_back(it.first);
+        }
+        std::sort(placement.nestedObjects.begin(), placement.nestedObjects.end());
+
+        for (const GAFAnimationFrame* frame : nested->m_animationFrames)
+        {
+            for (const GAFSubobjectState* state : frame->getObjectStates())
+            {
+                minNestedZ = std::min(minNestedZ, state->zIndex);
+                maxNestedZ = std::max(maxNestedZ, state->zIndex);
+            }
+        }
+        placements.push_back(std::move(placement));
+    }
+
+    if (placements.empty())
+    {
+        return nullptr;
+    }
+
+    if (minNestedZ > maxNestedZ)
+    {
+        minNestedZ = maxNestedZ = 0;
+    }
+
+    GAFTimeline* flat = new GAFTimeline(m_parent, m_id, m_aabb, m_pivot, m_framesCount);
+    flat->m_source = this; // Kept objects, texts and user data stay here, this timeline owns the flat one
+    flat->m_sceneFps = m_sceneFps;
+    flat->m_sceneWidth = m_sceneWidth;
+    flat->m_sceneHeight = m_sceneHeight;
+    flat->m_sceneColor = m_sceneColor;
+    flat->m_linkageName = m_linkageName;
+    flat->m_currentTextureAtlas = m_currentTextureAtlas; // Owned by this timeline
+    flat->m_usedAtlasContentScaleFactor = m_usedAtlasContentScaleFactor;
+    flat->m_animationMasks = m_animationMasks;
+    flat->m_animationObjects = m_animationObjects;
+    flat->m_animationSequences = m_animationSequences;
+    for (AnimationSequences_t::value_type& it : flat->m_animationSequences)
+    {
+        flat->m_sequencesIndex[it.first] = &it.second;
+    }
+    for (const NamedParts_t::value_type& it : m_namedParts)
+    {
+        flat->pushNamedPart(it.second, it.first);
+    }
+    flat->m_boundsState = m_boundsState;
+    flat->m_frameBounds = m_frameBounds;
+    flat->m_bounds = m_bounds;
+    flat->m_hitboxParts = m_hitboxParts;
+    flat->m_hitboxes = m_hitboxes;
+
+    // Kept objects keep their ids, nested objects get new ones
+    uint32_t nextFlatId = maxObjectId + 1;
+    for (Placement& placement : placements)
+    {
+        flat->m_animationObjects.erase(placement.objectId);
+        placement.firstFlatId = nextFlatId;
+        for (uint32_t nestedObjectId : placement.nestedObjects)
+        {
+            flat->m_animationObjects[nextFlatId] = placement.nested->m_animationObjects[nestedObjectId];
+            flat->m_objectSources[nextFlatId] = placement.nested->getObjectSource(nestedObjectId);
+            ++nextFlatId;
+        }
+    }
+
+    // Nested objects are drawn in place of their timeline: z = timeline z * stride + 1 + nested z
+    const int zStride = maxNestedZ - minNestedZ + 2;
+    std::unordered_map<uint32_t, size_t> placementsById;
+    for (size_t i = 0; i < placements.size(); ++i)
+    {
+        placementsById[placements[i].objectId] = i;
+    }
+
+    std::vector<GAFSubobjectState*> previousStates(nextFlatId, nullptr);
+    std::vector<const GAFSubobjectState*> previousSources(nextFlatId, nullptr);
+    std::vector<const GAFSubobjectState*> nestedStates;
+
+    for (uint32_t frameIndex = 0; frameIndex < m_animationFrames.size(); ++frameIndex)
+    {
+        const GAFAnimationFrame* frame = m_animationFrames[frameIndex];
+        GAFAnimationFrame* flatFrame = new GAFAnimationFrame();
+
+        for (const GAFSubobjectState* state : frame->getObjectStates())
+        {
+            std::unordered_map<uint32_t, size_t>::const_iterator placementIt = placementsById.find(state->objectIdRef);
+            if (placementIt == placementsById.end())
+            {
+                // States are shared while they do not change, so are their copies
+                GAFSubobjectState*& previous = previousStates[state->objectIdRef];
+                if (previousSources[state->objectIdRef] != state)
+                {
+                    GAFSubobjectState* copy = _copyState(state, state->objectIdRef, state->zIndex * zStride);
+                    flatFrame->pushObjectState(copy);
+                    copy->release();
+                    previous = copy;
+                    previousSources[state->objectIdRef] = state;
+                }
+                else
+                {
+                    flatFrame->pushObjectState(previous);
+                }
+                continue;
+            }
+
+            const Placement& placement = placements[placementIt->second];
+            const uint32_t nestedFrame = placement.nestedFrames[frameIndex];
+            if (nestedFrame != IDNONE)
+            {
+                nestedStates.assign(placement.nestedObjects.size(), nullptr);
+                for (const GAFSubobjectState* nestedState : placement.nested->m_animationFrames[nestedFrame]->getObjectStates())
+                {
+                    std::vector<uint32_t>::const_iterator it = std::lower_bound(placement.nestedObjects.begin(), placement.nestedObjects.end(), nestedState->objectIdRef);
+                    if (it != placement.nestedObjects.end() && *it == nestedState->objectIdRef)
+                    {
+                        nestedStates[it - placement.nestedObjects.begin()] = nestedState;
+                    }
+                }
+            }
+
+            for (size_t i = 0; i < placement.nestedObjects.size(); ++i)
+            {
+                const uint32_t flatId = placement.firstFlatId + static_cast<uint32_t>(i);
+                GAFSubobjectState* flatState = nullptr;
+                if (nestedFrame != IDNONE && nestedStates[i])
+                {
+                    flatState = _copyState(nestedStates[i], flatId, state->zIndex * zStride + 1 + nestedStates[i]->zIndex - minNestedZ);
+                    flatState->maskObjectIdRef = state->maskObjectIdRef;
+                    flatState->affineTransform = ax::AffineTransformConcat(nestedStates[i]->affineTransform, state->affineTransform);
+                    flatState->cocosTransform = ax::AffineTransformConcat(nestedStates[i]->cocosTransform, state->cocosTransform);
+                    for (int c = 0; c < 4; ++c)
+                    {
+                        flatState->colorMults()[c] = state->colorMults()[c] * nestedStates[i]->colorMults()[c];
+                        flatState->colorOffsets()[c] = state->colorOffsets()[c] + nestedStates[i]->colorOffsets()[c];
+                    }
+                }
+                else
+                {
+                    flatState = new GAFSubobjectState();
+                    flatState->initEmpty(flatId);
+                    flatState->zIndex = state->zIndex * zStride;
+                }
+
+                GAFSubobjectState*& previous = previousStates[flatId];
+                if (previous && previous->isEqual(*flatState))
+                {
+                    flatState->release();
+                    flatState = previous;
+                    flatFrame->pushObjectState(flatState);
+                }
+                else
+                {
+                    flatFrame->pushObjectState(flatState);
+                    flatState->release();
+                    previous = flatState;
+                }
+            }
+        }
+
+        for (const GAFTimelineAction& action : frame->getTimelineActions())
+        {
+            flatFrame->pushTimelineAction(action);
+        }
+        flat->pushAnimationFrame(flatFrame);
+    }
+
+    flat->prepare();
+    return flat;
+}
+
+GAFSubobjectState* GAFTimeline::_copyState(const GAFSubobjectState* state, uint32_t objectId, int zIndex)
+{
+    GAFSubobjectState* copy = new GAFSubobjectState();
+    copy->objectIdRef = objectId;
+    copy->maskObjectIdRef = state->maskObjectIdRef;
+    copy->zIndex = zIndex;
+    copy->affineTransform = state->affineTransform;
+    copy->cocosTransform = state->cocosTransform;
+    memcpy(copy->colorMults(), state->colorMults(), sizeof(float) * 4);
+    memcpy(copy->colorOffsets(), state->colorOffsets(), sizeof(float) * 4);
+    return copy;
+}
+
 float GAFTimeline::usedAtlasScale() const
 {
     return m_usedAtlasContentScaleFactor;
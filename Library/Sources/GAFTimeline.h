@@ -2,24 +2,74 @@
 
 #include "GAFCollections.h"
 #include "GAFHeader.h"
+#include "GAFTimelineEvent.h"
 
 #include "GAFDelegates.h"
 
 NS_GAF_BEGIN
 
 class GAFTextureAtlas;
+class GAFEvaluationCache;
+class GAFSubobjectState;
+
+/// Load time statistics of objects which keep the same state over the whole timeline
+struct GAFStaticStats
+{
+    uint32_t objectCount = 0;
+    uint32_t staticObjectCount = 0;
+    uint32_t timelineCount = 0;
+    uint32_t staticTimelineCount = 0; // Timelines without actions where every object is static
+};
+
+/// Quad of a named part in timeline space (Flash axes), baked per frame
+struct GAFHitbox
+{
+    ax::Vec2 points[4]; // Corners of the part bounds in order, the quad is oriented as the part is
+    bool     isVisible = false;
+};
 
 class GAFTimeline : public ax::Object
 {
 private:
+    typedef std::vector<uint32_t> ChangeFrames_t;
+
     TextureAtlases_t        m_textureAtlases;
     AnimationMasks_t        m_animationMasks;
     AnimationObjects_t      m_animationObjects;
     AnimationFrames_t       m_animationFrames;
     AnimationSequences_t    m_animationSequences;
+    SequencesByFrame_t      m_sequencesByFirstFrame;
+    SequencesByFrame_t      m_sequencesByLastFrame;
+    SequencesIndex_t        m_sequencesIndex;
     NamedParts_t            m_namedParts;
+    NamedPartsIndex_t       m_namedPartsIndex;
     TextsData_t             m_textsData;
 
+    std::vector<ChangeFrames_t> m_objectChangeFrames; // Object id -> frames where the object state differs from the previous frame
+    GAFStaticStats          m_staticStats;
+
+    enum class BoundsState : uint8_t
+    {
+        None = 0,
+        Baking,
+        Baked
+    };
+    BoundsState             m_boundsState;
+    std::vector<ax::Rect>   m_frameBounds; // Frame -> bounds of the visible content in timeline space
+    ax::Rect                m_bounds;      // Union of all frame bounds
+
+    TimelineEvents_t        m_events;
+
+    GAFEvaluationCache*     m_evaluationCache;
+
+    typedef std::unordered_map<uint32_t, GAFTimeline*> ObjectSources_t;
+    GAFTimeline*            m_flattened;     // Flattened copy, this if nothing can be flattened
+    GAFTimeline*            m_source;        // Timeline a flattened copy is built from, null for parsed ones
+    ObjectSources_t         m_objectSources; // Object id -> timeline of a flattened nested object
+
+    std::unordered_map<uint32_t, uint32_t> m_hitboxParts; // Object id of a named part -> hitbox part index
+    std::vector<GAFHitbox>  m_hitboxes;                   // Part index * frames count + frame
+
     uint32_t                m_id;
     ax::Rect           m_aabb;
     ax::Point          m_pivot;
@@ -41,6 +91,17 @@ private:
     GAFTimeline*            m_parent; // weak
 
     void                    _chooseTextureAtlas(float desiredAtlasScale);
+    void                    _analyzeStaticObjects();
+    void                    _convertTransforms();
+    void                    _indexEvents();
+    void                    _bakeHitboxes(const Timelines_t& timelines, const std::vector<ax::Rect>& objectBounds, const std::vector<bool>& hasObjectBounds);
+    bool                    _getObjectBounds(uint32_t objectId, const Timelines_t& timelines, ax::Rect& bounds);
+    GAFTimeline*            _flatten(const Timelines_t& timelines);
+    bool                    _canBeFlattened() const;
+    bool                    _isPlayedInLoop() const;
+    bool                    _hasFilters() const;
+    bool                    _getNestedFrames(uint32_t objectId, uint32_t nestedFramesCount, std::vector<uint32_t>& nestedFrames) const;
+    static GAFSubobjectState* _copyState(const GAFSubobjectState* state, uint32_t objectId, int zIndex);
 public:
 
     GAFTimeline(GAFTimeline* parent, uint32_t id, const ax::Rect& aabb, ax::Point& pivot, uint32_t framesCount);
@@ -73,13 +134,15 @@ public:
     const ax::Rect         getRect() const;
     const ax::Point        getPivot() const;
 
-    const std::string           getLinkageName() const;
+    const std::string&          getLinkageName() const;
 
     /// get GAFAnimationSequence by name specified in editor
-    const GAFAnimationSequence* getSequence(const std::string& name) const;
-    /// get GAFAnimationSequence by last frame number in sequence	
+    const GAFAnimationSequence* getSequence(std::string_view name) const;
+    /// get object id of the named part, IDNONE if there is no such part
+    uint32_t                    getNamedPartId(std::string_view name) const;
+    /// get GAFAnimationSequence by last frame number in sequence. O(1) after prepare()
     const GAFAnimationSequence* getSequenceByLastFrame(size_t frame) const;
-    /// get GAFAnimationSequence by first frame number in sequence	
+    /// get GAFAnimationSequence by first frame number in sequence. O(1) after prepare()
     const GAFAnimationSequence* getSequenceByFirstFrame(size_t frame) const;
 
     GAFTimeline*                getParent() const;
@@ -87,17 +150,74 @@ public:
     GAFTextureAtlas*            getTextureAtlas();
     void                        loadImages(float desiredAtlasScale);
 
+    /// Builds runtime lookup data. Called once all tags of the asset are read
+    void                        prepare();
+
+    /// Object keeps the same state in every frame of the timeline
+    bool                        isObjectStatic(uint32_t objectId) const;
+    /// Object keeps the same state in every frame from first to last inclusive
+    bool                        isObjectStatic(uint32_t objectId, uint32_t first, uint32_t last) const;
+    /// Timeline has no actions and all its objects are static
+    bool                        isStatic() const;
+    const GAFStaticStats&       getStaticStats() const;
+
+    /// Bakes bounds of every frame and sequence from the chosen atlas. Nested timelines are baked first
+    /// and contribute the union of all their frames. Called after loadImages, when the asset is parsed,
+    /// so the bounds only depend on atlas elements and the chosen atlas scale, not on loaded textures
+    void                        bakeBounds(const Timelines_t& timelines);
+    /// Bounds of the visible content of the frame in timeline space (Flash axes), zero if the frame is empty
+    const ax::Rect&             getFrameBounds(uint32_t frame) const;
+    /// Union of the bounds of all frames
+    const ax::Rect&             getBounds() const;
+    /// Hitbox of the named part object in the frame, baked with the bounds. Null if the part is not drawn.
+    /// A nested timeline part uses the bounds of the nested frame shown in the frame when that frame is known
+    /// in advance: this timeline and the nested one have no sequences, stops and gotos, see getFlattened.
+    /// Otherwise the union of all nested frames is used
+    const GAFHitbox*            getHitbox(uint32_t objectId, uint32_t frame) const;
+    /// Hitbox of the named part in the frame
+    const GAFHitbox*            getHitbox(std::string_view partName, uint32_t frame) const;
+
+    /// Dispatch event actions and sequence boundaries of all frames sorted by frame.
+    /// Within a frame sequences start first, then event and sound actions go in their authored order, then sequences end
+    const TimelineEvents_t&     getEvents() const;
+    /// Events from the first frame to the last one inclusive. O(log n)
+    TimelineEventsRange_t       getEvents(uint32_t first, uint32_t last) const;
+    /// First event on a frame after the given one, null if there are no more events. O(log n)
+    const GAFTimelineEvent*     getNextEvent(uint32_t frame) const;
+
     float                       usedAtlasScale() const;
 
+    /// Lets objects playing the same frame with the same inputs share evaluated states.
+    /// @note not to be changed while objects are evaluated on worker threads
+    void                        setEvaluationCacheEnabled(bool enabled);
+    GAFEvaluationCache*         getEvaluationCache() const { return m_evaluationCache; }
+
+    /// Copy of the timeline with nested timelines expanded into their objects. Only done when this timeline has no
+    /// sequences and no stop or goto actions, so it can only play all its frames in a loop. A nested timeline is
+    /// expanded if it has no actions, sequences, masks, named parts and filters, and its frames follow the frames of
+    /// this timeline in that loop. Nested objects are simulated the way they play by default, not looped: they stop
+    /// on their last frame until they are reset, so setLooped on the object does not reach expanded children.
+    /// @note expanded timelines advance with this one, so pause, stop and gotoAndStop freeze them too, while
+    /// nested objects would keep playing. Do not enable flattening for assets relying on that.
+    /// Built on the first call after the textures are loaded
+    /// @returns this timeline if nothing can be flattened
+    GAFTimeline*                getFlattened(const Timelines_t& timelines);
+    /// Timeline the atlas and texts of the object come from. For a flattened copy it is the timeline of an
+    /// expanded object, or the timeline the copy is built from for kept objects
+    GAFTimeline*                getObjectSource(uint32_t objectId);
+    const GAFTimeline*          getObjectSource(uint32_t objectId) const;
+
 
     // Custom fiels functionality
 public:
-    void appendUserData(const std::string& K, GAFAnyInterface* V) { m_userData[K] = V; }
+    /// Flattened copies share the user data of the timeline they are built from
+    void appendUserData(const std::string& K, GAFAnyInterface* V) { (m_source ? m_source : this)->m_userData[K] = V; }
 
     template<class T> T getUserData(const std::string& K) 
     {
-        CustomData_t::const_iterator it = m_userData.find(K);
-        if (it == m_userData.end()) return T();
+        const CustomData_t& userData = (m_source ? m_source : this)->m_userData;
+        CustomData_t::const_iterator it = userData.find(K);
+        if (it == userData.end()) return T();
         
         return reinterpret_cast<GAFAny<T>*>(it->second)->data;
     }
@@ -1,18 +1,32 @@
 #include "GAFPrecompiled.h"
 #include "GAFTimelineAction.h"
+#include "GAFTimeline.h"
+#include "GAFEventRegistry.h"
+
+#include <rapidjson/document.h>
 
 NS_GAF_BEGIN
 
+static const std::string s_emptyParam;
+
 GAFTimelineAction::GAFTimelineAction()
 : m_type(GAFActionType::None)
+, m_frame(IDNONE)
+, m_isSoundEvent(false)
+, m_eventId(IDNONE)
 {
-
+    m_soundCue.id = IDNONE;
+    m_soundCue.syncEvent = GAFSoundInfo::SyncEvent::Start;
+    m_soundCue.repeat = 1;
 }
 
 void GAFTimelineAction::setAction(GAFActionType type, ActionParams_t params, const std::string& scope)
 {
     m_type = type;
     m_scope = scope;
+    m_frame = IDNONE;
+    m_isSoundEvent = false;
+    m_eventId = IDNONE;
 
     switch (type)
     {
@@ -29,23 +43,73 @@ void GAFTimelineAction::setAction(GAFActionType type, ActionParams_t params, con
     case GAFActionType::DispatchEvent:
         AXASSERT(params.size() > 0 && params.size() < 5, "Something wrong with action parameters");
         m_params = params;
+        m_isSoundEvent = getParam(PI_EVENT_TYPE) == GAFSoundInfo::SoundEvent;
+        if (m_isSoundEvent)
+        {
+            parseSoundCue();
+        }
+        else
+        {
+            m_eventId = GAFEventRegistry::intern(getParam(PI_EVENT_TYPE));
+        }
         break;
     default:
         break;
     }
 }
 
-GAFActionType GAFTimelineAction::getType()
+GAFActionType GAFTimelineAction::getType() const
 {
     return m_type;
 }
 
-const std::string GAFTimelineAction::getParam(ParameterIndex idx)
+const std::string& GAFTimelineAction::getParam(ParameterIndex idx) const
 {
-	if (m_params.size() <= idx)
-		return "";
+    if (m_params.size() <= idx)
+        return s_emptyParam;
 
     return m_params[idx];
 }
 
+void GAFTimelineAction::resolveFrame(const GAFTimeline* timeline)
+{
+    if (m_type != GAFActionType::GotoAndStop && m_type != GAFActionType::GotoAndPlay)
+    {
+        return;
+    }
+
+    const std::string& frameLabel = getParam(PI_FRAME);
+
+    const GAFAnimationSequence* seq = timeline->getSequence(frameLabel);
+    if (seq)
+    {
+        m_frame = seq->startFrameNo;
+        return;
+    }
+
+    uint32_t frameNumber = atoi(frameLabel.c_str());
+    m_frame = frameNumber == 0 ? IDNONE : frameNumber - 1;
+}
+
+void GAFTimelineAction::parseSoundCue()
+{
+    rapidjson::Document doc;
+    doc.Parse<0>(getParam(PI_EVENT_DATA).c_str());
+
+    if (doc.HasParseError() || !doc.IsObject() || !doc.HasMember("id") || !doc.HasMember("action"))
+    {
+        AXLOGERROR("Cannot parse sound event parameters: %s", getParam(PI_EVENT_DATA).c_str());
+        return;
+    }
+
+    m_soundCue.id = doc["id"].GetInt();
+    m_soundCue.syncEvent = static_cast<GAFSoundInfo::SyncEvent>(doc["action"].GetInt());
+
+    if (doc.HasMember("repeat"))
+    {
+        m_soundCue.repeat = doc["repeat"].GetInt();
+        if (m_soundCue.repeat == 0) m_soundCue.repeat = 1;
+    }
+}
+
 NS_GAF_END
\ No newline at end of file
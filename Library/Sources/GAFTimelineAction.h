@@ -1,6 +1,7 @@
 #pragma once
 #include "GAFMacros.h"
 #include "GAFCollections.h"
+#include "GAFSoundInfo.h"
 
 NS_GAF_BEGIN
 
@@ -9,6 +10,14 @@ typedef std::vector<std::string> ActionParams_t;
 class GAFTimelineAction
 {
 public:
+    /// Parameters of the sound event, parsed when the action is loaded
+    struct SoundCue
+    {
+        uint32_t                id;
+        GAFSoundInfo::SyncEvent syncEvent;
+        int32_t                 repeat;
+    };
+
     GAFTimelineAction();
 
 	enum ParameterIndex
@@ -21,13 +30,30 @@ public:
 	};
 
     void setAction(GAFActionType type, ActionParams_t params, const std::string& scope);
-    GAFActionType getType();
-	const std::string getParam(ParameterIndex idx);
+    GAFActionType getType() const;
+    const std::string& getParam(ParameterIndex idx) const;
+
+    /// Resolves goto frame label against the timeline that owns the action
+    void resolveFrame(const GAFTimeline* timeline);
+    /// Frame index of GotoAndStop/GotoAndPlay actions, IDNONE if the label is unknown
+    uint32_t getFrame() const { return m_frame; }
+
+    bool isSoundEvent() const { return m_isSoundEvent; }
+    /// Interned type of DispatchEvent actions that are not sound events, IDNONE otherwise
+    uint32_t getEventId() const { return m_eventId; }
+    const SoundCue& getSoundCue() const { return m_soundCue; }
 
 private:
+    void parseSoundCue();
+
     GAFActionType m_type;
     ActionParams_t m_params;
     std::string m_scope;
+
+    uint32_t m_frame;
+    bool m_isSoundEvent;
+    SoundCue m_soundCue;
+    uint32_t m_eventId;
 };
 
 NS_GAF_END
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "GAFCollections.h"
+
+NS_GAF_BEGIN
+
+class GAFTimelineAction;
+
+/// Event action or sequence boundary of a timeline frame, indexed by GAFTimeline at load
+class GAFTimelineEvent
+{
+public:
+    enum class Type : uint8_t
+    {
+        SequenceStart = 0,
+        Event,
+        Sound,
+        SequenceEnd
+    };
+
+    uint32_t                    frame;
+    Type                        type;
+    const GAFTimelineAction*    action;   // Event and Sound, null for sequence boundaries
+    const GAFAnimationSequence* sequence; // SequenceStart and SequenceEnd, null for actions
+};
+
+typedef std::vector<GAFTimelineEvent> TimelineEvents_t; // Sorted by frame
+typedef std::pair<TimelineEvents_t::const_iterator, TimelineEvents_t::const_iterator> TimelineEventsRange_t;
+
+NS_GAF_END
@@ -0,0 +1,96 @@
+#include "GAFPrecompiled.h"
+#include "GAFWorkerPool.h"
+
+NS_GAF_BEGIN
+
+GAFWorkerPool::GAFWorkerPool(unsigned threadsCount)
+: m_job(nullptr)
+, m_jobsCount(0)
+, m_nextJob(0)
+, m_activeWorkers(0)
+, m_generation(0)
+, m_isStopping(false)
+{
+    m_threads.reserve(threadsCount);
+    for (unsigned i = 0; i < threadsCount; ++i)
+    {
+        m_threads.emplace_back(&GAFWorkerPool::workerLoop, this);
+    }
+}
+
+GAFWorkerPool::~GAFWorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+    }
+    m_wakeUp.notify_all();
+
+    for (std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void GAFWorkerPool::parallelFor(size_t count, const Job_t& job)
+{
+    if (m_threads.empty() || count < 2)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            job(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &job;
+        m_jobsCount = count;
+        m_nextJob = 0;
+        m_activeWorkers = m_threads.size();
+        ++m_generation;
+    }
+    m_wakeUp.notify_all();
+
+    runJobs();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_activeWorkers == 0; });
+    m_job = nullptr;
+}
+
+void GAFWorkerPool::workerLoop()
+{
+    uint64_t generation = 0;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeUp.wait(lock, [this, generation] { return m_isStopping || m_generation != generation; });
+            if (m_isStopping)
+            {
+                return;
+            }
+            generation = m_generation;
+        }
+
+        runJobs();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_activeWorkers == 0)
+        {
+            m_done.notify_one();
+        }
+    }
+}
+
+void GAFWorkerPool::runJobs()
+{
+    for (size_t i = m_nextJob++; i < m_jobsCount; i = m_nextJob++)
+    {
+        (*m_job)(i);
+    }
+}
+
+NS_GAF_END
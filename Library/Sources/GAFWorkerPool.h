@@ -0,0 +1,45 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+NS_GAF_BEGIN
+
+/// Fixed set of threads running the iterations of a loop in parallel.
+/// The calling thread takes part in the work and waits until the loop is done
+class GAFWorkerPool
+{
+public:
+    typedef std::function<void(size_t)> Job_t;
+
+    explicit GAFWorkerPool(unsigned threadsCount);
+    ~GAFWorkerPool();
+
+    unsigned getThreadsCount() const { return static_cast<unsigned>(m_threads.size()); }
+
+    /// Calls job for every index in [0, count)
+    void parallelFor(size_t count, const Job_t& job);
+
+private:
+    void workerLoop();
+    void runJobs();
+
+    typedef std::vector<std::thread> Threads_t;
+
+    Threads_t               m_threads;
+    std::mutex              m_mutex;
+    std::condition_variable m_wakeUp;
+    std::condition_variable m_done;
+
+    const Job_t*            m_job;
+    size_t                  m_jobsCount;
+    std::atomic<size_t>     m_nextJob;
+    size_t                  m_activeWorkers;
+    uint64_t                m_generation; // Changes with every loop, wakes the workers up
+    bool                    m_isStopping;
+};
+
+NS_GAF_END
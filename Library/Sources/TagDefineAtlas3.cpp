@@ -68,8 +68,6 @@ void TagDefineAtlas3::read(GAFStream* in, GAFAsset* asset, GAFTimeline* timeline
         element->bounds.origin = origin;
         element->bounds.size = ax::Size(width, height);
 
-        txAtlas->pushElement(element->elementAtlasIdx, element);
-
         char hasScale9Grid = in->readUByte();
 
         if (hasScale9Grid)
@@ -85,7 +83,8 @@ void TagDefineAtlas3::read(GAFStream* in, GAFAsset* asset, GAFTimeline* timeline
         int8_t rotation = in->readSByte();
         element->rotation = static_cast<GAFRotation>(rotation);
         in->readString(&element->name);
-        
+
+        txAtlas->pushElement(element->elementAtlasIdx, element);
     }
 
     if (timeline)
@@ -0,0 +1,180 @@
+#include "AllocationTest.h"
+#include "../testResource.h"
+#include "GAFPlaybackManager.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::function<Layer*()> createFunctions[] = {
+    CL(PlaybackAllocationTest),
+    CL(NestedAllocationTest),
+    CL(FiltersAllocationTest),
+    CL(DropShadowAllocationTest),
+};
+
+static int sceneIdx = -1;
+#define MAX_LAYER (sizeof(createFunctions) / sizeof(createFunctions[0]))
+
+DEFAULT_NEXT_ACTION;
+DEFAULT_BACK_ACTION;
+DEFAULT_RESTART_ACTION;
+
+#if GAF_TESTS_COUNT_ALLOCATIONS
+// Allocations are counted only on the thread that armed the counter and only while it is armed.
+// Memory taken with malloc directly is not seen. The operators are replaced for the whole app,
+// so they are only built in with GAF_TESTS_COUNT_ALLOCATIONS
+static thread_local bool s_isCountingAllocations = false;
+static std::atomic<size_t> s_allocationsCount(0);
+
+void* operator new(std::size_t size)
+{
+    if (s_isCountingAllocations)
+    {
+        ++s_allocationsCount;
+    }
+
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+#endif
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+
+void BaseAllocationTest::onEnter()
+{
+    BaseTest::onEnter();
+
+    gaf::GAFObject* object = gaf_object();
+    if (!object)
+    {
+        return;
+    }
+
+    object->setAnchorPoint(Vec2::ANCHOR_MIDDLE);
+    object->setPosition(VisibleRect::center());
+    addChild(object);
+
+    TTFConfig ttfConfig("fonts/arial.ttf", 28);
+    auto label = Label::createWithTTF(ttfConfig, run(object), TextHAlignment::CENTER);
+    label->setPosition(VisibleRect::bottom() + Vec2(0, 80));
+    addChild(label);
+}
+
+std::string BaseAllocationTest::run(gaf::GAFObject* object)
+{
+#if GAF_TESTS_COUNT_ALLOCATIONS
+    gaf::GAFPlaybackManager* manager = gaf::GAFPlaybackManager::getInstance();
+    const uint32_t frames = object->getTotalFrameCount();
+    const float dt = 1.f / object->getFps();
+
+    // Two loops fill the caches and grow the reused arrays to their steady size
+    for (uint32_t i = 0; i < frames * 2; ++i)
+    {
+        manager->update(dt);
+    }
+
+    s_allocationsCount = 0;
+    s_isCountingAllocations = true;
+    for (uint32_t i = 0; i < frames; ++i)
+    {
+        manager->update(dt);
+    }
+    s_isCountingAllocations = false;
+
+    const size_t count = s_allocationsCount;
+    const std::string result = fmt::format("{} allocations in {} frames\n{}", count, frames, count ? "FAILED" : "PASSED");
+    AXLOGD("Allocations, {}: {}", subtitle(), result);
+    return result;
+#else
+    (void)object;
+    return "Counting is off\nConfigure with -DGAF_TESTS_COUNT_ALLOCATIONS=ON";
+#endif
+}
+
+std::string BaseAllocationTest::title() const
+{
+    return "Allocations per loop";
+}
+
+std::string BaseAllocationTest::subtitle() const
+{
+    return "---";
+}
+
+TEPLATE_CALLBACK_FUNCTION(BaseAllocationTest, back, AllocationTestScene);
+TEPLATE_CALLBACK_FUNCTION(BaseAllocationTest, next, AllocationTestScene);
+TEPLATE_CALLBACK_FUNCTION(BaseAllocationTest, restart, AllocationTestScene);
+
+static gaf::GAFObject* createObject(const char* path)
+{
+    auto asset = gaf::GAFAsset::create(path);
+    // Engine events are dispatched with allocated payloads
+    asset->setEngineEventsEnabled(false);
+    return asset->createObjectAndRun(true);
+}
+
+std::string PlaybackAllocationTest::subtitle() const
+{
+    return "Single timeline";
+}
+
+gaf::GAFObject* PlaybackAllocationTest::gaf_object()
+{
+    return createObject(s_gafStandart1);
+}
+
+std::string NestedAllocationTest::subtitle() const
+{
+    return "Nested timelines";
+}
+
+gaf::GAFObject* NestedAllocationTest::gaf_object()
+{
+    return createObject(s_gafMultipleTimelines);
+}
+
+std::string FiltersAllocationTest::subtitle() const
+{
+    return "Filters";
+}
+
+gaf::GAFObject* FiltersAllocationTest::gaf_object()
+{
+    return createObject(s_gafFiltersSample);
+}
+
+std::string DropShadowAllocationTest::subtitle() const
+{
+    return "Animated drop shadow";
+}
+
+gaf::GAFObject* DropShadowAllocationTest::gaf_object()
+{
+    // The shadowed object moves every frame, so every frame has its own equal drop shadow filter
+    return createObject(s_gafFiltersShadow);
+}
+
+/////////////////////////////////////////////////////////////
+
+void AllocationTestScene::runThisTest()
+{
+    auto layer = nextAction();
+    addChild(layer);
+    Director::getInstance()->replaceScene(this);
+}
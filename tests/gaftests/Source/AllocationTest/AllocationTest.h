@@ -0,0 +1,71 @@
+#pragma once
+
+#include "../testBasic.h"
+#include "../BaseTest.h"
+
+class BaseAllocationTest : public BaseTest
+{
+public:
+    CREATE_FUNC(BaseAllocationTest);
+
+    virtual void onEnter() override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    /// @returns object to measure, it is added to the layer before the ticks
+    virtual gaf::GAFObject* gaf_object() { return nullptr; }
+
+    DEFAULT_ACTION_CALLBACKS(AllocationTestScene);
+
+private:
+    std::string run(gaf::GAFObject* object);
+};
+
+class PlaybackAllocationTest : public BaseAllocationTest
+{
+public:
+    CREATE_FUNC(PlaybackAllocationTest);
+
+    virtual std::string subtitle() const override;
+
+    virtual gaf::GAFObject* gaf_object() override;
+};
+
+class NestedAllocationTest : public BaseAllocationTest
+{
+public:
+    CREATE_FUNC(NestedAllocationTest);
+
+    virtual std::string subtitle() const override;
+
+    virtual gaf::GAFObject* gaf_object() override;
+};
+
+class FiltersAllocationTest : public BaseAllocationTest
+{
+public:
+    CREATE_FUNC(FiltersAllocationTest);
+
+    virtual std::string subtitle() const override;
+
+    virtual gaf::GAFObject* gaf_object() override;
+};
+
+class DropShadowAllocationTest : public BaseAllocationTest
+{
+public:
+    CREATE_FUNC(DropShadowAllocationTest);
+
+    virtual std::string subtitle() const override;
+
+    virtual gaf::GAFObject* gaf_object() override;
+};
+
+////////////////////////////////////////////
+class AllocationTestScene : public TestScene
+{
+public:
+    CREATE_FUNC(AllocationTestScene);
+
+    virtual void runThisTest() override;
+};
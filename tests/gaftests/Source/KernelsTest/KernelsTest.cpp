@@ -0,0 +1,204 @@
+#include "KernelsTest.h"
+#include "../testResource.h"
+#include "GAFKernels.h"
+
+#include <chrono>
+
+static std::function<Layer*()> createFunctions[] = {
+    CL(KernelsCorrectnessTest),
+    CL(KernelsBenchmarkTest),
+};
+
+static int sceneIdx = -1;
+#define MAX_LAYER (sizeof(createFunctions) / sizeof(createFunctions[0]))
+
+DEFAULT_NEXT_ACTION;
+DEFAULT_BACK_ACTION;
+DEFAULT_RESTART_ACTION;
+
+/// Input, kernel output and scalar output of a batch in SoA layout
+class KernelsBatch
+{
+public:
+    explicit KernelsBatch(size_t count)
+    : m_count(count)
+    , m_data(count * 14 * 3)
+    {
+        // Deterministic values with negative, fractional and large components
+        for (size_t i = 0; i < m_data.size(); ++i)
+        {
+            m_data[i] = std::sin(static_cast<float>(i) * 0.37f) * (i % 7 == 0 ? 100.f : 2.f);
+        }
+    }
+
+    gaf::GAFTransformsSoA transforms(size_t set)
+    {
+        float* p = m_data.data() + set * m_count * 14;
+        return { p, p + m_count, p + m_count * 2, p + m_count * 3, p + m_count * 4, p + m_count * 5 };
+    }
+
+    gaf::GAFColorsSoA colors(size_t set)
+    {
+        float* p = m_data.data() + set * m_count * 14 + m_count * 6;
+        gaf::GAFColorsSoA result;
+        for (int ch = 0; ch < 4; ++ch)
+        {
+            result.mults[ch] = p + m_count * ch;
+            result.offsets[ch] = p + m_count * (4 + ch);
+        }
+        return result;
+    }
+
+    /// Largest difference between the components of two sets
+    float maxDifference(size_t set1, size_t set2) const
+    {
+        float result = 0.f;
+        const float* p1 = m_data.data() + set1 * m_count * 14;
+        const float* p2 = m_data.data() + set2 * m_count * 14;
+        for (size_t i = 0; i < m_count * 14; ++i)
+        {
+            result = std::max(result, std::fabs(p1[i] - p2[i]));
+        }
+        return result;
+    }
+
+    size_t count() const { return m_count; }
+
+private:
+    size_t m_count;
+    std::vector<float> m_data;
+};
+
+static const ax::AffineTransform s_parentTransform = ax::AffineTransformMake(1.25f, 0.5f, -0.75f, 0.8f, 30.f, -12.f);
+static const float s_parentMults[4] = { 0.5f, 1.f, 2.f, 0.25f };
+static const float s_parentOffsets[4] = { 0.1f, -0.2f, 0.3f, 0.f };
+
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////////
+
+bool BaseKernelsTest::init()
+{
+    if (BaseTest::init())
+    {
+        TTFConfig ttfConfig("fonts/arial.ttf", 28);
+        auto label = Label::createWithTTF(ttfConfig, run(), TextHAlignment::CENTER);
+        label->setPosition(VisibleRect::center());
+        addChild(label);
+        return true;
+    }
+    return false;
+}
+
+std::string BaseKernelsTest::title() const
+{
+    return std::string("Kernels: ") + gaf::GAFKernels::getInstructionSet();
+}
+
+std::string BaseKernelsTest::subtitle() const
+{
+    return "---";
+}
+
+TEPLATE_CALLBACK_FUNCTION(BaseKernelsTest, back, KernelsTestScene);
+TEPLATE_CALLBACK_FUNCTION(BaseKernelsTest, next, KernelsTestScene);
+TEPLATE_CALLBACK_FUNCTION(BaseKernelsTest, restart, KernelsTestScene);
+
+std::string KernelsCorrectnessTest::subtitle() const
+{
+    return "Kernels against the scalar reference";
+}
+
+std::string KernelsCorrectnessTest::run()
+{
+    // Sizes cover empty batches, tails shorter than a vector and several full vectors
+    const size_t sizes[] = { 0, 1, 3, 4, 5, 8, 17, 64, 1001 };
+    const float tolerance = 1e-4f;
+
+    std::string result;
+    bool isPassed = true;
+    for (size_t count : sizes)
+    {
+        KernelsBatch batch(count);
+        gaf::GAFKernels::concatTransforms(batch.transforms(0), s_parentTransform, batch.transforms(1), count);
+        gaf::GAFKernels::concatTransformsScalar(batch.transforms(0), s_parentTransform, batch.transforms(2), 0, count);
+        gaf::GAFKernels::composeColorTransforms(batch.colors(0), s_parentMults, s_parentOffsets, batch.colors(1), count);
+        gaf::GAFKernels::composeColorTransformsScalar(batch.colors(0), s_parentMults, s_parentOffsets, batch.colors(2), 0, count);
+
+        // In place composition must give the same result
+        gaf::GAFKernels::concatTransforms(batch.transforms(0), s_parentTransform, batch.transforms(0), count);
+        gaf::GAFKernels::composeColorTransforms(batch.colors(0), s_parentMults, s_parentOffsets, batch.colors(0), count);
+
+        const float difference = std::max(batch.maxDifference(1, 2), batch.maxDifference(0, 2));
+        if (difference > tolerance)
+        {
+            isPassed = false;
+            result += fmt::format("count {}: difference {}\n", count, difference);
+        }
+    }
+
+    // Single transform matches the engine concatenation
+    KernelsBatch single(1);
+    gaf::GAFTransformsSoA t = single.transforms(0);
+    const ax::AffineTransform expected = ax::AffineTransformConcat(
+        ax::AffineTransformMake(*t.a, *t.b, *t.c, *t.d, *t.tx, *t.ty), s_parentTransform);
+    gaf::GAFKernels::concatTransforms(t, s_parentTransform, t, 1);
+    if (std::fabs(*t.a - expected.a) > tolerance || std::fabs(*t.b - expected.b) > tolerance
+        || std::fabs(*t.c - expected.c) > tolerance || std::fabs(*t.d - expected.d) > tolerance
+        || std::fabs(*t.tx - expected.tx) > tolerance || std::fabs(*t.ty - expected.ty) > tolerance)
+    {
+        isPassed = false;
+        result += "AffineTransformConcat mismatch\n";
+    }
+
+    result += isPassed ? "PASSED" : "FAILED";
+    AXLOGD("Kernels correctness: {}", result);
+    return result;
+}
+
+std::string KernelsBenchmarkTest::subtitle() const
+{
+    return "Microbenchmark, 256 states per batch";
+}
+
+std::string KernelsBenchmarkTest::run()
+{
+    typedef std::chrono::steady_clock Clock_t;
+    const size_t count = 256;
+    const int iterations = 20000;
+
+    KernelsBatch batch(count);
+    gaf::GAFTransformsSoA in = batch.transforms(0);
+    gaf::GAFTransformsSoA out = batch.transforms(1);
+    gaf::GAFColorsSoA colorsIn = batch.colors(0);
+    gaf::GAFColorsSoA colorsOut = batch.colors(1);
+
+    auto measure = [&](const std::function<void()>& kernel) {
+        const Clock_t::time_point start = Clock_t::now();
+        for (int i = 0; i < iterations; ++i)
+        {
+            kernel();
+        }
+        return std::chrono::duration<double, std::nano>(Clock_t::now() - start).count() / (double(iterations) * count);
+    };
+
+    const double concat = measure([&]() { gaf::GAFKernels::concatTransforms(in, s_parentTransform, out, count); });
+    const double concatScalar = measure([&]() { gaf::GAFKernels::concatTransformsScalar(in, s_parentTransform, out, 0, count); });
+    const double color = measure([&]() { gaf::GAFKernels::composeColorTransforms(colorsIn, s_parentMults, s_parentOffsets, colorsOut, count); });
+    const double colorScalar = measure([&]() { gaf::GAFKernels::composeColorTransformsScalar(colorsIn, s_parentMults, s_parentOffsets, colorsOut, 0, count); });
+
+    const std::string result = fmt::format(
+        "Transforms: {:.2f} ns/state, scalar {:.2f} ns/state\nColors: {:.2f} ns/state, scalar {:.2f} ns/state",
+        concat, concatScalar, color, colorScalar);
+    AXLOGD("Kernels benchmark:\n{}", result);
+    return result;
+}
+
+/////////////////////////////////////////////////////////////
+
+void KernelsTestScene::runThisTest()
+{
+    auto layer = nextAction();
+    addChild(layer);
+    Director::getInstance()->replaceScene(this);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "../testBasic.h"
+#include "../BaseTest.h"
+
+class BaseKernelsTest : public BaseTest
+{
+public:
+    CREATE_FUNC(BaseKernelsTest);
+
+    virtual bool init() override;
+
+    virtual std::string title() const override;
+    virtual std::string subtitle() const override;
+    /// @returns text of the results shown under the title
+    virtual std::string run() { return ""; }
+
+    DEFAULT_ACTION_CALLBACKS(KernelsTestScene);
+};
+
+class KernelsCorrectnessTest : public BaseKernelsTest
+{
+public:
+    CREATE_FUNC(KernelsCorrectnessTest);
+
+    virtual std::string subtitle() const override;
+
+    virtual std::string run() override;
+};
+
+class KernelsBenchmarkTest : public BaseKernelsTest
+{
+public:
+    CREATE_FUNC(KernelsBenchmarkTest);
+
+    virtual std::string subtitle() const override;
+
+    virtual std::string run() override;
+};
+
+////////////////////////////////////////////
+class KernelsTestScene : public TestScene
+{
+public:
+    CREATE_FUNC(KernelsTestScene);
+
+    virtual void runThisTest() override;
+};
@@ -34,8 +34,10 @@ typedef struct _Controller{
     //
     { "Events", []() { return new EventsTestScene(); } },
     { "Filters", []() { return new FiltersTestScene(); } },
+    { "General: Allocations", []() { return new AllocationTestScene(); } },
     { "General: Bundles", []() { return new BundlesTestScene(); } },
     { "General: Flip", []() { return new FlipTestScene(); } },
+    { "General: Kernels", []() { return new KernelsTestScene(); } },
     { "General: Multiple timelines", []() { return new MultipleTimelineTestScene(); } },
     { "General: Playback", []() { return new FramePlaybackTestScene(); } },
     { "Masks: Timelines", []() { return new MaskTimelineTestScene(); } },
@@ -7,4 +7,6 @@
 #include "MultipleTimelineTest/MultipleTimelineTest.h"
 #include "BundlesTest/BundlesTest.h"
 #include "UITest/UITest.h"
-#include "EventsTest/EventsTest.h"
\ No newline at end of file
+#include "EventsTest/EventsTest.h"
+#include "KernelsTest/KernelsTest.h"
+#include "AllocationTest/AllocationTest.h"
\ No newline at end of file